@@ -2,12 +2,50 @@
 #include <memory>
 #include <vector>
 #include <cstdint>
+#include <string>
 
 
 namespace smbios {
 
 class NativePhysicalMemory;
 
+/// @brief How physical memory is accessed
+/// Small areas are cheaper to read() into a buffer than to map and fault them in
+enum class PhysicalMemoryAccess {
+    Auto,   // Read if area is smaller than the read threshold, Map otherwise
+    Read,   // pread() into own buffer (POSIX only, Windows always maps)
+    Map     // mmap() a window (shared and cached on POSIX)
+};
+
+/// @brief Read-only window into the mapped physical memory, does not own anything
+/// Valid only while the mapping it has been taken from is alive and not re-mapped
+class PhysicalMemoryView {
+public:
+
+    /// @brief Empty view
+    PhysicalMemoryView() = default;
+
+    /// @brief View over the mapped bytes
+    PhysicalMemoryView(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    /// @brief View beginning
+    const uint8_t* data() const { return data_; }
+
+    /// @brief View size in bytes
+    size_t size() const { return size_; }
+
+    /// @brief Requested area was not mapped
+    bool empty() const { return nullptr == data_ || 0 == size_; }
+
+    /// @brief STL-style access
+    const uint8_t* begin() const { return data_; }
+    const uint8_t* end() const { return data_ + size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
 /// @brief System-independent class that map and dump raw physical memory
 /// Usually requires administrator or root privileges
 /// Could access only 1st megabyte as it contains some service data
@@ -18,13 +56,16 @@ public:
     PhysicalMemory();
 
     /// @brief Create mapping with provided base offset and size
-    PhysicalMemory(size_t base, size_t length);
+    /// POSIX device is '<root_path>/dev/mem', empty root is '/'
+    PhysicalMemory(size_t base, size_t length, PhysicalMemoryAccess access = PhysicalMemoryAccess::Auto,
+                   const std::string& root_path = std::string());
 
     /// @brief Call Unmap memory
     ~PhysicalMemory();
 
     /// @brief Map to empty class or re-map memory
-    void map_physical_memory(size_t base, size_t length);
+    void map_physical_memory(size_t base, size_t length, PhysicalMemoryAccess access = PhysicalMemoryAccess::Auto,
+                             const std::string& root_path = std::string());
 
     /// @brief Check whether physical memory is mapped
     bool is_mapped() const;
@@ -32,12 +73,37 @@ public:
     /// @brief Dump area of physical memory into page-aligned byte array
     std::vector<uint8_t> get_memory_dump(size_t offset, size_t length) const;
 
+    /// @brief Zero-copy view of the mapped area, offset is counted from the requested base
+    /// (not from the page-aligned mapping beginning). Empty if area is beyond the mapping
+    PhysicalMemoryView get_memory_view(size_t offset, size_t length) const;
+
     /// @brief get page-aligned offset from beginning of tha mapping
     const uint8_t* get_memory_offset(size_t offset) const;
 
+    /// @brief Offset of the requested base from the page-aligned beginning of the mapping,
+    /// so that get_memory_offset(get_page_offset()) points exactly to the requested base
+    size_t get_page_offset() const;
+
     /// @brief Unmap memory
     void unmap_memory();
 
+    /// @brief Unmap cached mappings not used by any PhysicalMemory object
+    /// (POSIX keeps '/dev/mem' open and mapped areas cached to reuse them later)
+    static void release_cached_mappings();
+
+    /// @brief Areas smaller than threshold are read, larger are mapped (Auto access)
+    static void set_read_threshold(size_t threshold);
+
+    /// @brief Current read threshold
+    static size_t get_read_threshold();
+
+    /// @brief Measure read and map of growing areas starting from base on the running kernel,
+    /// set and return threshold where mapping becomes cheaper. Requires access to the area
+    static size_t calibrate_read_threshold(size_t base, size_t max_length);
+
+    /// @brief Resolve Auto access for the area length
+    static PhysicalMemoryAccess select_access(size_t length, PhysicalMemoryAccess access);
+
 private:
 
     /// PImpl
@@ -0,0 +1,36 @@
+#pragma once
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Small POSIX file helpers for the firmware pseudo-files (sysfs, procfs)
+// Pseudo-files often report zero or fake size, so read until EOF
+
+namespace smbios {
+
+/// @brief Absolute path inside the filesystem root, empty root is '/'
+/// Firmware pseudo-files could be published into a shared directory or a fixture tree
+std::string make_rooted_path(const std::string& root_path, const std::string& path);
+
+/// @brief Read the whole file into the buffer using pread(), buffer is pre-sized from fstat()
+/// so that regular and sysfs binary files are read with one kernel-to-user copy
+/// @return false if file could not be opened, read or empty
+bool read_file_contents(const std::string& path, std::vector<uint8_t>& contents);
+
+/// @brief Write the file readable by the owner only, readers never see it partially written:
+/// contents go to the temporary file which is renamed to the path
+/// @return false if file could not be written
+bool write_file_atomically(const std::string& path, const std::vector<uint8_t>& contents);
+
+/// @brief Regular file (symbolic link is not followed) owned by the effective user
+/// and not writable by group and others, so that it could not be planted in the shared directory
+bool is_private_file(const std::string& path);
+
+/// @brief Names of directory entries, except '.' and '..'
+/// @return false if directory could not be opened
+bool list_directory(const std::string& path, std::vector<std::string>& names);
+
+} // namespace smbios
+
+#endif // defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
@@ -3,19 +3,115 @@
 #include <vector>
 #include <cstdint>
 #include <memory>
+#include <mutex>
+#include <map>
+#include <string>
 
-namespace boost {
-namespace iostreams {
-class mapped_file_source;
+namespace smbios {
 
-} // namespace iostreams 
-} // namespace boost 
+class PhysicalMemoryView;
+enum class PhysicalMemoryAccess;
 
-namespace smbios {
+/// @brief Page-aligned read-only mmap() window of '/dev/mem', unmapped in destructor
+/// Windows are shared between mappings and cached by the pool
+class PhysicalMemoryWindow {
+public:
+
+    /// @brief Map page-aligned area, throws std::system_error
+    PhysicalMemoryWindow(int device_fd, size_t aligned_base, size_t aligned_length);
+
+    /// @brief munmap()
+    ~PhysicalMemoryWindow();
+
+    PhysicalMemoryWindow(const PhysicalMemoryWindow&) = delete;
+    PhysicalMemoryWindow& operator=(const PhysicalMemoryWindow&) = delete;
+
+    /// @brief Window contains the whole [base, base + length) physical area
+    bool contains(size_t base, size_t length) const;
+
+    /// @brief Window and [base, base + length) physical area have common bytes
+    bool overlaps(size_t base, size_t length) const;
+
+    /// @brief Virtual address of the physical address inside window
+    const uint8_t* address_of(size_t physical_address) const;
+
+    /// @brief Page-aligned physical base
+    size_t base() const { return base_; }
+
+    /// @brief Page-aligned length
+    size_t length() const { return length_; }
+
+private:
+    const uint8_t* address_ = nullptr;
+    size_t base_ = 0;
+    size_t length_ = 0;
+};
+
+/// @brief Process-wide pool of '/dev/mem' mappings, one per filesystem root
+/// Keeps the device descriptor open, reuses cached windows which contain the requested area,
+/// and unmaps windows lazily: unused windows stay cached until evicted or released explicitly
+class PhysicalMemoryPool {
+public:
+
+    /// @brief Process-wide instance for '<root_path>/dev/mem', empty root is '/'
+    static PhysicalMemoryPool& instance(const std::string& root_path = std::string());
+
+    /// @brief Release unused windows of all pools
+    static void release_all_unused();
+
+    /// @brief Close device and release all windows not used by any mapping
+    ~PhysicalMemoryPool();
+
+    /// @brief Get window containing [base, base + length), map it if necessary
+    /// Throws std::system_error if device could not be opened or mapped
+    std::shared_ptr<const PhysicalMemoryWindow> acquire(size_t base, size_t length);
+
+    /// @brief pread() [base, base + length) into the buffer using the same device descriptor
+    /// Throws std::system_error if device could not be opened or read
+    void read(size_t base, size_t length, uint8_t* buffer);
+
+    /// @brief Unmap all cached windows not used by any mapping, device stays open
+    void release_unused();
+
+    /// @brief System page size
+    static size_t page_size();
+
+private:
+
+    explicit PhysicalMemoryPool(const std::string& device_path);
+
+    /// Open device once, under lock
+    int device_descriptor();
+
+    /// Drop the oldest unused windows if cache is full, under lock
+    void evict_unused();
+
+private:
+
+    /// Unused windows kept mapped for later requests
+    static const size_t max_cached_windows_ = 8;
+
+    /// Pools by device path
+    static std::mutex pools_lock_;
+    static std::map<std::string, std::unique_ptr<PhysicalMemoryPool>> pools_;
+
+    /// Physical memory device
+    const std::string device_path_;
+
+    /// Protect cache and descriptor
+    std::mutex pool_lock_;
+
+    /// '/dev/mem' descriptor, kept open for the process lifetime
+    int device_fd_ = -1;
+
+    /// Cached windows, the most recently used are at the end
+    std::vector<std::shared_ptr<PhysicalMemoryWindow>> windows_;
+};
 
 /// @brief POSIX-specific class that map and dump raw physical memory
-/// Requires root privileges. Do not call POSIX mmap()/munmap() directly,
-/// Boost MMF wrapping '/dev/mem' provide necessary functionality and RAII
+/// Requires root privileges. Mapping is a part of the window from the process-wide
+/// PhysicalMemoryPool, so that repeated mappings of the same area do not open
+/// '/dev/mem' or call mmap()/munmap() again. Small areas are rather read into own buffer
 /// Do not use directly! Use system-independent wrapper PhysicalMemory
 class NativePhysicalMemory{
 public:
@@ -24,14 +120,14 @@ public:
     NativePhysicalMemory();
 
     /// @brief Create mapping with provided base offset and size
-    /// Use Boost.Iostreams MMF as wrapper
-    NativePhysicalMemory(size_t base, size_t length);
+    /// Device is '<root_path>/dev/mem', empty root is '/'
+    NativePhysicalMemory(size_t base, size_t length, PhysicalMemoryAccess access, const std::string& root_path);
 
-    /// @brief MMF is RAII
+    /// @brief Window is released to the pool
     ~NativePhysicalMemory();
 
-    /// @brief Create new mapping
-    void map_physical_memory(size_t base, size_t length);
+    /// @brief Create new mapping, or read the area if access is PhysicalMemoryAccess::Read
+    void map_physical_memory(size_t base, size_t length, PhysicalMemoryAccess access, const std::string& root_path);
 
     /// @brief Check whether physical memory is mapped
     bool is_mapped() const;
@@ -39,18 +135,39 @@ public:
     /// @brief Dump area of physical memory into page-aligned byte array
     std::vector<uint8_t> get_memory_dump(size_t offset, size_t length) const;
 
+    /// @brief Zero-copy view of the mapped area, offset from the requested base
+    PhysicalMemoryView get_memory_view(size_t offset, size_t length) const;
+
     /// @brief get page-aligned offset from beginning of the mapping
     const uint8_t* get_memory_offset(size_t offset) const;
 
-    /// @brief Unmap memory, close MMF
+    /// @brief Offset of the requested base from the page-aligned beginning of the mapping
+    size_t get_page_offset() const;
+
+    /// @brief Release window to the pool
     void unmap_memory();
 
+    /// @brief Unmap cached windows which are not used anymore
+    static void release_cached_mappings();
+
 private:
 
-    /// Wrapper for MMF /dev/mem
-    std::unique_ptr<boost::iostreams::mapped_file_source> physical_memory_map_;
+    /// Shared window from the pool
+    std::shared_ptr<const PhysicalMemoryWindow> window_;
+
+    /// Page-aligned area read from the device (read access)
+    std::vector<uint8_t> read_buffer_;
+
+    /// Page-aligned beginning of the mapping inside the window
+    const uint8_t* mapping_begin_ = nullptr;
+
+    /// Page-aligned mapping length
+    size_t mapping_length_ = 0u;
+
+    /// System page offset
+    size_t page_offset_ = 0u;
 };
 
 } // namespace smbios
 
-#endif // defined(_WIN32) || defined(_WIN64)
\ No newline at end of file
+#endif // defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Raw SMBIOS data as returned by Windows GetSystemFirmwareTable('RSMB'):
+// short header with version information followed by the structure table.
+// Layout is fixed, so blobs uploaded from Windows hosts are parsed on any system
+
+namespace smbios {
+
+#pragma pack(push, 1)
+
+/// @brief SMBIOS header+table beginning
+struct RawSMBIOSData {
+    uint8_t calling_method;
+    uint8_t major_version;
+    uint8_t minor_version;
+    uint8_t dmi_revision;
+    uint32_t length;
+    uint8_t smbios_table_data[1];
+};
+
+#pragma pack(pop)
+
+/// @brief Size of the header before the structure table
+constexpr size_t raw_smbios_data_header_size = 8;
+
+/// @brief Header fields and the structure table inside the blob
+struct RawSMBiosDataInfo
+{
+    /// SMBIOS version major.minor
+    size_t major_version = 0;
+    size_t minor_version = 0;
+
+    /// DMI revision
+    size_t dmi_revision = 0;
+
+    /// Structure table, points into the blob
+    const uint8_t* table = nullptr;
+
+    /// Structure table length
+    size_t table_length = 0;
+};
+
+/// @brief Recognize the header and locate the structure table, nothing is copied
+/// The header is recognized by SMBIOS major version 2 or 3 and table length which fits the blob,
+/// raw table is never taken for it: the second byte of the table is structure length (at least 4)
+/// @return false if the data is not a raw SMBIOS data blob or it is truncated
+bool parse_raw_smbios_data(const uint8_t* data, size_t length, RawSMBiosDataInfo& info);
+
+} // namespace smbios
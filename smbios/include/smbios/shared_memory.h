@@ -0,0 +1,51 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Read-only POSIX shared memory segment: one privileged process publishes bytes,
+// any number of unprivileged processes map them in place. Not supported on Windows
+
+namespace smbios {
+
+/// @brief Read-only mapping of the published segment
+class SharedMemorySegment
+{
+public:
+
+    /// @brief Map the whole segment read-only, name is POSIX shared memory name ("/smbios")
+    /// Throws std::system_error if the segment could not be opened or mapped
+    explicit SharedMemorySegment(const std::string& name);
+
+    /// @brief Unmap the segment, published segment stays
+    ~SharedMemorySegment();
+
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    /// @brief Segment beginning
+    const uint8_t* data() const;
+
+    /// @brief Segment size in bytes
+    size_t size() const;
+
+    /// @brief Replace the segment with the bytes, readable by everyone and writable by nobody
+    /// Readers which have already mapped the previous segment keep it, new readers get
+    /// the new one. First 8 bytes are written last, so that reader never takes partial
+    /// contents for the complete ones if it checks the signature there
+    /// Throws std::system_error if the segment could not be created
+    static void publish(const std::string& name, const std::vector<uint8_t>& contents);
+
+    /// @brief Remove the published segment name, mapped segments stay valid
+    /// @return false if there is no such segment
+    static bool remove(const std::string& name);
+
+private:
+
+    /// Mapping
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+} // namespace smbios
@@ -1,15 +1,32 @@
 #pragma once
 #include <vector>
+#include <array>
 #include <memory>
+#include <string>
+#include <set>
 #include <cstdint>
+#include <limits>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <smbios/smbios_entry_point.h>
+#include <smbios/smbios_acquisition.h>
 
 // Main SMBIOS table implementation
 
-class PhysicalMemory;
+namespace boost {
+namespace iostreams {
+class mapped_file_source;
+
+} // namespace iostreams
+} // namespace boost
 
 namespace smbios {
 
 class SMBiosImpl;
+class PhysicalMemory;
+class SharedMemorySegment;
 
 // should be aligned to be mapped to the physical memory
 #pragma pack(push, 1)
@@ -28,14 +45,13 @@ struct SMBIOSEntryPoint32 {
     uint8_t intermediate_anchor[5];
     uint8_t intermediate_checksum;
     uint16_t structure_table_length;
-    intptr_t structure_table_address;
+    uint32_t structure_table_address;
     uint16_t smbios_structures_number;
     uint8_t smbios_bcd_revision;
 };
 
 /// @brief SMBIOS entry point for 64-bit systems
 /// Contains 1 checksum, 1 anchor
-/// Size is not exact unlike for 32 version but it is guaranteed enough
 struct SMBIOSEntryPoint64 {
     uint8_t entry_point_anchor[5];
     uint8_t entry_point_checksum;
@@ -43,9 +59,21 @@ struct SMBIOSEntryPoint64 {
     uint8_t major_version;
     uint8_t minor_version;
     uint8_t smbios_docrev;
+    uint8_t entry_point_revision;
     uint8_t reserved;
     uint32_t max_structure_size;
-    intptr_t structure_table_address;
+    uint64_t structure_table_address;
+};
+
+/// @brief Legacy DMI entry point (pre-SMBIOS 2.1 systems)
+/// Same as the intermediate part of 32-bit entry point, version is BCD-encoded
+struct SMBIOSEntryPointLegacy {
+    uint8_t entry_point_anchor[5];
+    uint8_t entry_point_checksum;
+    uint16_t structure_table_length;
+    uint32_t structure_table_address;
+    uint16_t smbios_structures_number;
+    uint8_t smbios_bcd_revision;
 };
 
 /// @brief Each SMBIOS structure begins with that four-byte header
@@ -87,6 +115,17 @@ struct SMBiosVersion
 bool operator >(const SMBiosVersion& lhs, const SMBiosVersion& rhs);
 bool operator <(const SMBiosVersion& lhs, const SMBiosVersion& rhs);
 
+/// @brief Entry point of the source, without the table
+struct SMBiosProbe
+{
+    /// Source the entry point has been read from
+    SMBiosSource source = SMBiosSource::None;
+
+    /// Version, table address, length and structures count
+    /// Anchor type is SMBiosAnchorType::NoHeader if the source has no entry point (firmware table, dump files)
+    SMBiosEntryPointInfo entry_point;
+};
+
 /// @brief Class owns system-independent SMBIOS table 
 /// which however has been read using system-dependent API
 /// It also have a cache like table structures count and headers
@@ -118,17 +157,83 @@ public:
     };
 
     /// @brief Read SMBIOS table using native OS-specific method
+    /// Falls back to the physical memory scan (default acquisition policy)
     SMBios();
+
+    /// @brief Try sources of the policy in order, the first successful one is used
+    /// Boot cache of the policy is used instead of the sources if it matches the running system
+    /// Throws std::runtime_error if no one of sources was successful within the time limits
+    explicit SMBios(const AcquisitionPolicy& policy);
+
+    /// @brief Process-wide table shared by all consumers, acquired with the default policy
+    /// on the first call only (thread-safe, concurrent callers wait for it)
+    /// Throws std::runtime_error if the table could not be acquired, the next call tries again
+    static std::shared_ptr<const SMBios> instance();
+
+    /// @brief Acquire the table again and replace the process-wide one,
+    /// holders of the previous table keep using it until they release it
+    static std::shared_ptr<const SMBios> refresh_instance(const AcquisitionPolicy& policy = AcquisitionPolicy{});
+
+    /// @brief Read and checksum only the entry point, the table is never read or mapped
+    /// Sources of the policy are tried in order without time limits, entry point reads are tiny
+    /// Throws std::runtime_error if no one of sources provides the entry point
+    static SMBiosProbe probe(const AcquisitionPolicy& policy = AcquisitionPolicy{});
+
+    /// @brief Completion callback of the asynchronous creation: the object or the error
+    typedef std::function<void(std::unique_ptr<SMBios> smbios, std::exception_ptr error)> CreationCallback;
+
+    /// @brief Acquire and index the table on the background thread, the caller is not blocked
+    /// Future waits for the result, it holds std::runtime_error if no source was successful
+    /// or the acquisition has been cancelled (AcquisitionPolicy::cancel_flag)
+    static std::future<SMBios> create_async(const AcquisitionPolicy& policy = AcquisitionPolicy{});
+
+    /// @brief The same, callback is called on the background thread
+    static void create_async(const AcquisitionPolicy& policy, CreationCallback callback);
+
+    /// @brief Read and index only structures of wanted types (/sys/firmware/dmi/entries),
+    /// so that cost depends on the requested data, not on the table size
+    /// Where per-type entries are not available the whole table is acquired with the default
+    /// policy and only wanted types are indexed. Structures count is the number of indexed ones
+    /// Paths are taken inside the filesystem root, empty root is '/'
+    explicit SMBios(const std::set<uint8_t>& types, const std::string& root_path = std::string());
+
+    /// @brief Index SMBIOS table dump file (smbios_util --dump-file) in place,
+    /// the file is memory-mapped and never copied
+    /// Raw table dump does not contain the entry point, so the version should be provided
+    /// Raw SMBIOS data blob saved on Windows and dmidecode --dump-bin file are recognized,
+    /// version is taken from their headers. Snapshot file (make_snapshot()) is not scanned at all,
+    /// its precomputed index is used
+    explicit SMBios(const std::string& dump_file_path, const SMBiosVersion& dump_version = SMBiosVersion{});
+
+    /// @brief Index caller-owned table memory in place, no allocation for the table and no copy
+    /// Memory should outlive the object. Optional entry point provides version information
+    /// and is validated, std::runtime_error is thrown if it is broken
+    SMBios(const uint8_t* table, size_t table_size, const uint8_t* entry_point = nullptr, size_t entry_point_size = 0);
+
+    /// @brief Index raw SMBIOS data blob (Windows GetSystemFirmwareTable('RSMB') output) in place,
+    /// version is taken from the blob header. Blob memory should outlive the object
+    /// Throws std::runtime_error if the blob header is not recognized
+    static SMBios from_raw_smbios_data(const uint8_t* raw_data, size_t raw_data_size);
     
     /// @brief Should be exist to satisfy compiler
     ~SMBios();
 
+    /// @brief Table memory is owned by the source, so it stays in place when moved
+    SMBios(SMBios&&);
+    SMBios& operator=(SMBios&&);
+
+    /// @brief Which source has been used and how long every tried source took
+    const AcquisitionReport& get_acquisition_report() const;
+
     /// @brief Get SMBIOS version
     SMBiosVersion get_smbios_version() const;
 
     /// @brief Get SMBIOS structures stored in class
     size_t get_structures_count() const;
 
+    /// @brief Number of indexed structures of the type, counted while the index is built
+    size_t get_structures_count(uint8_t type) const;
+
     /// @brief Actual table base (offset from header beginning)
     const uint8_t* get_table_base()  const;
 
@@ -138,6 +243,36 @@ public:
     /// Display SMBIOS description
     std::string render_to_description() const;
 
+    /// @brief Selects structures for find_structures()
+    typedef std::function<bool(const DMIHeader& header)> StructurePredicate;
+
+    /// @brief Walk the table from the beginning and stop as soon as max_matches structures are found
+    /// The index is neither built nor used, so lazily indexed object reads only the table head
+    /// to find e.g. BIOS Information. Headers point into the table and live as long as the object
+    std::vector<DMIHeader> find_structures(const StructurePredicate& predicate,
+                                           size_t max_matches = std::numeric_limits<size_t>::max()) const;
+
+    /// @brief Walk the table until max_matches structures of the types are found
+    std::vector<DMIHeader> find_structures(const std::set<uint8_t>& types,
+                                           size_t max_matches = std::numeric_limits<size_t>::max()) const;
+
+    /// @brief Compose dmidecode --dump-bin compatible image: entry point at the beginning
+    /// pointing to the table at dump_bin_table_offset. Original entry point is relocated,
+    /// it is synthesized from the version and the table if the source did not provide it
+    /// (or the table consists of per-type entries). Unknown version is synthesized as 3.0
+    /// Throws std::runtime_error if SMBIOS 2.x table is longer than 64K
+    std::vector<uint8_t> make_dump_bin() const;
+
+    /// @brief Compose snapshot file image (smbios_snapshot.h): entry point, version, source,
+    /// the table and the index of the structures this object provides
+    /// Throws std::runtime_error if the table is longer than 4 GB (index offsets are 32-bit)
+    std::vector<uint8_t> make_snapshot() const;
+
+    /// @brief Publish the snapshot into read-only POSIX shared memory segment (POSIX only),
+    /// so that unprivileged processes use it in place with SMBiosSource::SharedMemory step
+    /// Throws std::system_error if the segment could not be created
+    void publish_shared_memory(const std::string& name) const;
+
     /// @brief Implement bidirectional iterator for STL-style processing
     class iterator {
     public:
@@ -183,52 +318,97 @@ public:
     };
 
     /// @brief Iterator begin - for STL-style processing
-    iterator begin()
+    /// Headers could not be changed through the iterator, so const object is iterated as well
+    iterator begin() const
     {
         return iterator(get_headers_list());
     }
 
     /// @brief Iterator end - for STL-style processing
-    iterator end()
+    iterator end() const
     {
         return iterator(get_headers_list(), iterator::end);
     }
 
 private:
 
-    /// Friend-only access for iterator class
-    std::vector<DMIHeader>& get_headers_list();
+    /// Acquire the table from the only source, do not index it
+    /// Throws std::runtime_error if the source is not available
+    SMBios(SMBiosSource source, const AcquisitionPolicy& policy);
 
-    /// Parse and save headers for every entry
-    void read_smbios_table();
+    /// Try sources of the policy, move the first acquired table into this object
+    void acquire(const AcquisitionPolicy& policy);
 
-    /// Count all low-level structures stored in SMBios
-    /// Do it once at start
-    void count_smbios_structures();
+    /// Read the entry point of the only source
+    /// @return false if the source is not available
+    static bool probe_source(SMBiosSource source, const AcquisitionPolicy& policy, SMBiosEntryPointInfo& entry_point_info);
 
-    /// Fallback to physical memory scan if no one of system-specific interfaces
-    /// was available
-    void scan_physical_memory(const std::vector<uint8_t>& devmem_array);
+    /// Entry point of the dump file, or the version from policy and the file size for raw table dump
+    static bool probe_dump_file(const AcquisitionPolicy& policy, SMBiosEntryPointInfo& entry_point_info);
+
+    /// Map and use table dump file
+    void map_dump_file(const std::string& dump_file_path, const SMBiosVersion& dump_version);
+
+    /// Map the published snapshot, the table and the index are used in place
+    void attach_shared_memory(const std::string& name);
+
+    /// Map the boot cache snapshot into this object, the cache should be private to the user
+    /// and keep the same entry point as the probed one
+    /// @return false if the cache is missing, broken or does not match the firmware
+    bool read_boot_cache(const std::string& cache_path, const SMBiosEntryPointInfo& probed_entry_point);
+
+    /// Use snapshot parts in place, headers are taken from the index
+    /// @return false if the memory is not a snapshot
+    bool read_snapshot(const uint8_t* snapshot, size_t snapshot_size);
+
+    /// Friend-only access for iterator class
+    std::vector<DMIHeader>& get_headers_list() const;
+
+    /// Build the deferred index (lazy indexing) once, concurrent callers wait for it
+    void ensure_index() const;
 
-    /// Get DMI version major.minor
-    void extract_dmi_version();
+    /// Parse and save headers for every entry, count structures and their types
+    /// in the same single pass which stops at the end of table marker
+    void read_smbios_table() const;
 
-    /// Check correctness of 32-bit header checksum (see SMBIOS spec for details)
-    bool checksum32() const;
+    /// Per-type counts of the index which has not been built by read_smbios_table()
+    void count_structure_types() const;
 
-    /// Check correctness of 64-bit header checksum (see SMBIOS spec for details)
-    bool checksum64() const;
+    /// Validate and save raw entry point, extract version
+    bool read_entry_point(const uint8_t* entry_point, size_t entry_point_size);
 
-    /// checksum from start offset to offset+length should be zero
-    uint8_t smbios_crc(uint8_t start_offset, uint8_t length) const;
+    /// Save the entry point read by the native implementation, if it provides one
+    void read_native_entry_point();
+
+    /// Fallback to physical memory scan if no one of system-specific interfaces
+    /// was available. Table is indexed right inside the /dev/mem mapping
+    void read_from_physical_memory(const std::string& root_path);
 
 private:
 
     /// Raw SMBIOS table system-specific implementation
     std::unique_ptr<SMBiosImpl> native_impl_;
 
+    /// Memory-mapped table dump file
+    std::unique_ptr<boost::iostreams::mapped_file_source> dump_file_;
+
+    /// Published snapshot mapped from the shared memory
+    std::unique_ptr<SharedMemorySegment> shared_memory_;
+
+    /// Table mapped from the physical memory (memory scan fallback)
+    std::unique_ptr<PhysicalMemory> table_memory_;
+
+    /// Indexed table, points to the memory owned by one of the sources
+    const uint8_t* table_base_ = nullptr;
+
+    /// Indexed table size
+    size_t table_size_ = 0;
+
     /// Cached SMBIOS structures count
-    size_t structures_count_ = 0;
+    mutable size_t structures_count_ = 0;
+
+    /// Indexed structures count per type
+    mutable std::array<size_t, 256> type_counts_ = {};
 
     /// Cached major SMBIOS version
     size_t major_version_ = 0;
@@ -239,16 +419,26 @@ private:
     /// Save SMBIOS entry point here
     std::vector<uint8_t> entry_point_buffer_;
 
+    /// Validated entry point information
+    SMBiosEntryPointInfo entry_point_info_;
+
     /// Cached SMBIOS headers
-    std::vector<DMIHeader> headers_list_;
+    mutable std::vector<DMIHeader> headers_list_;
+
+    /// Set if indexing has been deferred until the first query
+    std::unique_ptr<std::once_flag> index_once_;
 
     /// Entry points, mapped to memory dump
     const SMBIOSEntryPoint32* smbios_entry32_ = nullptr;
     const SMBIOSEntryPoint64* smbios_entry64_ = nullptr;
+    const SMBIOSEntryPointLegacy* smbios_entry_legacy_ = nullptr;
 
     /// Set this flag if SMBIOS entry point checksum is valid
     bool checksum_validated_ = true;
 
+    /// Source of the table and latencies of tried sources
+    AcquisitionReport acquisition_report_;
+
     /// Scan physical memory from this address
     static const size_t devmem_base_ = 0xF0000;
 
@@ -0,0 +1,116 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// SMBIOS table acquisition policy: which sources are tried, in which order and how long
+
+namespace smbios {
+
+/// @brief Where SMBIOS table has been taken from
+enum class SMBiosSource {
+    None,
+    FirmwareTable,      // GetSystemFirmwareTable('RSMB'), Windows
+    SysFS,              // /sys/firmware/dmi/tables
+    SysFSEntries,       // /sys/firmware/dmi/entries, wanted structure types only
+    EFI,                // EFI system table entry point, table from physical memory
+    PhysicalMemoryScan, // Entry point scan of the legacy BIOS area in physical memory
+    DumpFile,           // Table dump file
+    Memory,             // Caller-owned memory
+    Cache,              // Boot-scoped table cache
+    SharedMemory        // Snapshot published into POSIX shared memory
+};
+
+/// @brief Printable source name
+const char* get_source_name(SMBiosSource source);
+
+/// @brief One source of the fallback chain
+struct AcquisitionStep
+{
+    SMBiosSource source = SMBiosSource::None;
+
+    /// Time given to the source, zero means no limit
+    /// Source which has not finished in time is abandoned (its thread is detached),
+    /// and the next source is tried
+    std::chrono::milliseconds budget{0};
+};
+
+/// @brief Ordered list of sources, the first successful one is used
+struct AcquisitionPolicy
+{
+    /// Native sources first, physical memory scan is the last resort
+    std::vector<AcquisitionStep> steps = default_steps();
+
+    /// Overall time limit for the whole chain, zero means no limit
+    /// Every step budget is cut to the time left, sources are skipped after the deadline
+    std::chrono::milliseconds deadline{0};
+
+    /// Filesystem root of sysfs, procfs and /dev/mem paths, empty means '/'
+    /// Tables published by a privileged exporter into a shared directory,
+    /// or fixture trees could be read the same way as the system ones
+    std::string root_path;
+
+    /// Table dump file for SMBiosSource::DumpFile step
+    std::string dump_file_path;
+
+    /// Dump file does not contain the entry point, version should be provided
+    uint16_t dump_major_version = 0;
+    uint16_t dump_minor_version = 0;
+
+    /// Set it from any thread to cancel the acquisition (e.g. on shutdown), null is not cancellable
+    /// Sources which have not been tried are skipped, the source being read is abandoned
+    /// (its thread is detached), so that the caller is not held by slow /dev/mem
+    std::shared_ptr<std::atomic<bool>> cancel_flag;
+
+    /// POSIX shared memory name for SMBiosSource::SharedMemory step (SMBios::publish_shared_memory())
+    std::string shared_memory_name;
+
+    /// Directory of the boot-scoped table cache, empty disables it (Linux only)
+    /// Acquired table and its index are saved as a snapshot keyed by the root, the boot id and the entry
+    /// point checksum, the following objects map it instead of reading firmware while the key matches
+    /// Only SysFS, SysFSEntries and EFI steps could make the key, cache is not used without them
+    std::string cache_directory;
+
+    /// Only acquire the table, structure headers are indexed on the first iteration or count query
+    /// (thread-safe), so that version and table size probes do not pay for the table scan
+    bool lazy_indexing = false;
+
+    /// @brief Default chain of the platform, without time limits
+    static std::vector<AcquisitionStep> default_steps();
+};
+
+/// @brief How the source attempt has ended
+enum class AcquisitionResult {
+    Success,
+    Failed,     // Source is not available or the table is broken
+    TimedOut,   // Source has not finished within its budget
+    Skipped     // Deadline has been reached before the source was tried
+};
+
+/// @brief Single source attempt
+struct AcquisitionAttempt
+{
+    SMBiosSource source = SMBiosSource::None;
+    AcquisitionResult result = AcquisitionResult::Skipped;
+    std::chrono::microseconds latency{0};
+
+    /// Failure reason, if any
+    std::string error;
+};
+
+/// @brief Which source has been used and how long every attempt took
+struct AcquisitionReport
+{
+    SMBiosSource source = SMBiosSource::None;
+
+    /// Source the snapshot file has been taken from (loaded snapshot only)
+    SMBiosSource snapshot_source = SMBiosSource::None;
+
+    std::vector<AcquisitionAttempt> attempts;
+    std::chrono::microseconds total_latency{0};
+};
+
+} // namespace smbios
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <smbios/smbios_entry_point.h>
+
+// Entry point scanner for raw memory areas: legacy BIOS area, firmware images, memory captures
+// Anchors are tested in wide blocks (SSE2/AVX2 where available), checksums are validated
+// only for candidates
+
+namespace smbios {
+
+/// @brief Scanner implementation, best supported one is selected at runtime by default
+/// If requested implementation is not supported by CPU or compiler, the next narrower is used
+enum class AnchorScanMethod {
+    Auto,
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+/// @brief Entry point found by the scanner
+struct SMBiosScanResult
+{
+    /// Beginning of the valid entry point inside scanned area, nullptr if nothing found
+    const uint8_t* entry_point = nullptr;
+
+    /// Validated entry point information
+    SMBiosEntryPointInfo info;
+};
+
+/// @brief Scan area for the valid SMBIOS entry point on every 16-byte (paragraph) boundary
+/// counted from the area beginning. SMBIOS3 entry point is preferred over 32-bit one,
+/// 32-bit is preferred over legacy DMI one. Scan stops at the first valid SMBIOS3 entry point
+SMBiosScanResult scan_smbios_entry_point(const uint8_t* area, size_t length,
+                                         AnchorScanMethod method = AnchorScanMethod::Auto);
+
+/// @brief Implementation which will be actually used for the requested method
+AnchorScanMethod resolve_anchor_scan_method(AnchorScanMethod method);
+
+} // namespace smbios
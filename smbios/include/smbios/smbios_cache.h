@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <smbios/smbios_acquisition.h>
+#include <smbios/smbios_entry_point.h>
+
+// Boot-scoped table cache: SMBIOS table could not change while the system is up, so the table
+// acquired once is saved as a snapshot and mapped by the following processes of the same boot.
+// Cache file name is made of the filesystem root hash, the boot id and the entry point checksum,
+// so that the cache of the previous boot or of the updated firmware is never used,
+// and the objects of different roots could share the cache directory
+
+namespace smbios {
+
+/// @brief Cache file of the current boot and entry point inside the policy cache directory
+/// Only the entry point is read (SMBios::probe()) from SysFS, SysFSEntries and EFI steps of the policy,
+/// boot id and paths are taken inside the policy root
+/// @return empty path if the cache is disabled or the key could not be made (no boot id, no such step,
+/// no entry point)
+std::string get_boot_cache_path(const AcquisitionPolicy& policy);
+
+/// @brief The same, probed entry point is returned for the comparison with the cached one
+std::string get_boot_cache_path(const AcquisitionPolicy& policy, SMBiosEntryPointInfo& entry_point_info);
+
+/// @brief Save the snapshot to the cache file atomically (owner-only access),
+/// cache files of other boots and entry points of the same root in the directory are removed
+/// @return false if the cache file could not be written
+bool store_boot_cache(const std::string& cache_path, const std::vector<uint8_t>& snapshot);
+
+} // namespace smbios
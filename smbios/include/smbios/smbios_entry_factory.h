@@ -7,6 +7,7 @@
 #include <smbios/bios_information_entry.h>
 #include <smbios/port_connection_entry.h>
 #include <smbios/memory_device_entry.h>
+#include <smbios/system_information_entry.h>
 
 namespace smbios {
 
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <smbios/smbios_anchor.h>
+
+// SMBIOS entry point validation, common for all the table sources
+// (sysfs, EFI, physical memory scan, dump files)
+
+namespace smbios {
+
+/// @brief Entry point fields which do not depend on the entry point format
+/// 32-bit, 64-bit and legacy DMI entry points are reduced to this set
+struct SMBiosEntryPointInfo
+{
+    /// Which anchor has been found
+    SMBiosAnchorType anchor_type = SMBiosAnchorType::NoHeader;
+
+    /// Entry point size in bytes (from the entry point itself)
+    size_t entry_point_length = 0;
+
+    /// SMBIOS version major.minor
+    size_t major_version = 0;
+    size_t minor_version = 0;
+
+    /// Physical address of the structure table
+    uint64_t table_address = 0;
+
+    /// Structure table length (32-bit), or maximum table size (64-bit)
+    size_t table_length = 0;
+
+    /// Number of structures, 64-bit entry point does not provide it (zero)
+    size_t structures_number = 0;
+
+    /// BCD-encoded version (0x21 is 2.1), 64-bit entry point does not provide it (zero)
+    size_t bcd_revision = 0;
+
+    /// Entry point checksum byte, changes together with any entry point field
+    uint8_t checksum = 0;
+};
+
+/// @brief Check anchor, length and checksum of the raw entry point
+/// and extract format-independent information from it
+/// @return false if the entry point is truncated or broken
+bool parse_smbios_entry_point(const uint8_t* entry_point, size_t length, SMBiosEntryPointInfo& info);
+
+/// @brief Table offset in dmidecode --dump-bin file, the entry point is at the file beginning
+constexpr size_t dump_bin_table_offset = 0x20;
+
+/// @brief Point the raw entry point to another table address and recompute its checksums
+/// (dmidecode --dump-bin file keeps the table right after the entry point)
+/// @return false if the anchor is not recognized, entry point is truncated or address does not fit
+bool relocate_smbios_entry_point(uint8_t* entry_point, size_t length, uint64_t table_address);
+
+} // namespace smbios
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <smbios/smbios_acquisition.h>
+
+// Self-describing SMBIOS snapshot file: entry point, version, acquisition source, the table
+// and the precomputed structure index. Snapshot is loaded with a single mapping,
+// structure headers are taken from the index without the table scan
+//
+// Layout: header | entry point | index | table, all parts are 8-byte aligned, little-endian
+
+namespace smbios {
+
+#pragma pack(push, 1)
+
+/// @brief Snapshot file header
+struct SMBiosSnapshotHeader
+{
+    uint8_t magic[8];
+    uint32_t format_version;
+    uint32_t header_length;
+    uint16_t major_version;
+    uint16_t minor_version;
+    uint8_t source;
+    uint8_t reserved[3];
+    uint32_t entry_point_offset;
+    uint32_t entry_point_length;
+    uint32_t index_offset;
+    uint32_t index_count;
+    uint32_t structures_count;
+    uint32_t reserved2;
+    uint64_t table_offset;
+    uint64_t table_length;
+};
+
+/// @brief Indexed structure, offset is counted from the table beginning,
+/// size includes strings section
+struct SMBiosSnapshotIndexEntry
+{
+    uint8_t type;
+    uint8_t length;
+    uint16_t handle;
+    uint32_t offset;
+    uint32_t size;
+};
+
+#pragma pack(pop)
+
+/// @brief Snapshot file signature
+constexpr uint8_t smbios_snapshot_magic[8] = {'S', 'M', 'B', 'S', 'N', 'A', 'P', 0};
+
+/// @brief Current format version, files of other versions are not recognized
+constexpr uint32_t smbios_snapshot_format_version = 1;
+
+/// @brief Snapshot parts, pointers are inside the snapshot memory
+struct SMBiosSnapshotInfo
+{
+    /// SMBIOS version major.minor
+    size_t major_version = 0;
+    size_t minor_version = 0;
+
+    /// Source the table has been acquired from
+    SMBiosSource source = SMBiosSource::None;
+
+    /// Raw entry point, empty if the source has not provided it
+    const uint8_t* entry_point = nullptr;
+    size_t entry_point_length = 0;
+
+    /// Precomputed index, every entry is within the table
+    const SMBiosSnapshotIndexEntry* index = nullptr;
+    size_t index_count = 0;
+
+    /// Structures count of the snapshot object
+    size_t structures_count = 0;
+
+    /// Structure table
+    const uint8_t* table = nullptr;
+    size_t table_length = 0;
+};
+
+/// @brief Recognize the snapshot and check that all its parts are inside the data
+/// @return false if the data is not a snapshot of the supported format version or it is truncated
+bool parse_smbios_snapshot(const uint8_t* data, size_t length, SMBiosSnapshotInfo& info);
+
+} // namespace smbios
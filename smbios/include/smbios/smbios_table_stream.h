@@ -0,0 +1,77 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <functional>
+#include <string>
+#include <smbios/smbios.h>
+#include <smbios/physical_memory.h>
+
+// Streaming walk over the SMBIOS table in physical memory
+// Table is never mapped at once: fixed-size window slides along the table,
+// so that memory use does not depend on the table size (SMBIOS 3.x allows up to 4 GB)
+
+namespace smbios {
+
+/// @brief Walk structures of the table through the sliding window
+/// Window always begins at the structure boundary: structure which crosses the window end
+/// is re-read from its beginning, window grows only if a single structure is larger than the window
+class SMBiosTableStream
+{
+public:
+
+    /// @brief Called for every structure except end of table marker
+    /// Header data points into the current window and is valid only during the call
+    /// @return false to stop the walk
+    typedef std::function<bool(const DMIHeader& header, size_t structure_size)> StructureVisitor;
+
+    /// @brief Default window size
+    static const size_t default_window_size = 256 * 1024;
+
+    /// @brief Stream over the table at physical address, table length is taken from entry point
+    /// (for SMBIOS 3.x it is the maximum size, walk stops on end of table marker)
+    /// Physical memory device is taken inside the filesystem root, empty root is '/'
+    SMBiosTableStream(uint64_t table_address, size_t table_length, size_t window_size = default_window_size,
+                      const std::string& root_path = std::string());
+
+    virtual ~SMBiosTableStream();
+
+    SMBiosTableStream(const SMBiosTableStream&) = delete;
+    SMBiosTableStream& operator=(const SMBiosTableStream&) = delete;
+
+    /// @brief Walk the table from the beginning
+    /// Throws std::system_error if physical memory could not be accessed
+    /// @return number of visited structures
+    size_t for_each_structure(const StructureVisitor& visitor);
+
+    /// @brief Largest window used by the last walk
+    size_t get_max_window_size() const;
+
+protected:
+
+    /// @brief Access [offset, offset + length) of the table, previous window is not used anymore
+    /// Reads physical memory into own buffer by default, so that windows are not cached
+    virtual PhysicalMemoryView map_window(size_t offset, size_t length);
+
+private:
+
+    /// Table physical address
+    uint64_t table_address_ = 0;
+
+    /// Table length
+    size_t table_length_ = 0;
+
+    /// Window size
+    size_t window_size_ = default_window_size;
+
+    /// Largest window used by the last walk
+    size_t max_window_size_ = 0;
+
+    /// Filesystem root of the physical memory device
+    std::string root_path_;
+
+    /// Current window
+    std::unique_ptr<PhysicalMemory> window_memory_;
+};
+
+} // namespace smbios
@@ -0,0 +1,39 @@
+#pragma once
+#include <string>
+
+// Host identity fast path: the most often queried System Information and BIOS Information
+// fields without SMBIOS table acquisition. Linux kernel exports them as small text attributes
+// in /sys/class/dmi/id, the table is decoded only for the fields which could not be read there
+
+namespace smbios {
+
+/// @brief Host identity fields, empty if not provided by firmware
+struct SystemIdentity
+{
+    /// System Information (type 1)
+    std::string product_uuid;
+    std::string product_serial;
+    std::string product_name;
+    std::string system_vendor;
+
+    /// BIOS Information (type 0)
+    std::string bios_vendor;
+    std::string bios_version;
+    std::string bios_date;
+
+    /// Some fields were taken from the SMBIOS table (attributes are missing or root-only)
+    bool decoded_from_table = false;
+};
+
+/// @brief Read identity now: /sys/class/dmi/id attributes, then System and BIOS Information
+/// structures for the missing fields. Never throws, unavailable fields are left empty
+/// Paths are taken inside the filesystem root, empty root is '/'
+SystemIdentity read_system_identity(const std::string& root_path = std::string());
+
+/// @brief Identity could not change while the system is up, so it is read once per process
+/// (process never outlives the boot, so no boot id is needed to tell the cache is stale)
+/// Empty identity is not cached: it is read again until some field becomes readable
+/// Thread-safe, the following calls cost one memory read. System root is used
+const SystemIdentity& get_system_identity();
+
+} // namespace smbios
@@ -0,0 +1,155 @@
+#pragma once
+#include <cstdint>
+#include <map>
+#include <smbios/abstract_smbios_entry.h>
+
+// System Information entry
+// See http://www.dmtf.org/standards/smbios
+// Standard according to current SMBIOS version, 'System Information' chapter
+// UUID byte order has been changed in 2.6 version
+
+namespace smbios {
+
+struct DMIHeader;
+struct SMBiosVersion;
+
+// should be aligned to be mapped to physical memory
+#pragma pack(push, 1)
+
+/// @brief SMBIOS System Information entry Ver 2.0
+struct SystemInformationV20 {
+    uint32_t header;
+    uint8_t manufacturer;
+    uint8_t product_name;
+    uint8_t version;
+    uint8_t serial_number;
+};
+
+/// @brief SMBIOS System Information entry Ver 2.1+
+struct SystemInformationV21 : public SystemInformationV20 {
+    uint8_t uuid[16];
+    uint8_t wakeup_type;
+};
+
+/// @brief SMBIOS System Information entry Ver 2.4+
+struct SystemInformationV24 : public SystemInformationV21 {
+    uint8_t sku_number;
+    uint8_t family;
+};
+
+#pragma pack(pop)
+
+/// @brief System Information structure: manufacturer, model, serial number and UUID of the system
+/// Only one structure is present in the table
+class SystemInformationEntry : public AbstractSMBiosEntry {
+public:
+
+    // @brief Wake-up Type field
+    enum WakeupType : uint8_t {
+        WakeupReserved = 0x00,
+        WakeupOther = 0x01,
+        WakeupUnknown = 0x02,
+        APMTimer = 0x03,
+        ModemRing = 0x04,
+        LANRemote = 0x05,
+        PowerSwitch = 0x06,
+        PCIPME = 0x07,
+        ACPowerRestored = 0x08
+    };
+
+    /// @brief Parse the header, recognize how much information do we have
+    /// in System Information SMBIOS entry depending on version and size (should be compliant)
+    SystemInformationEntry(const DMIHeader& header, const SMBiosVersion& version);
+
+    // @brief Parent is abstract
+    virtual ~SystemInformationEntry() = default;
+
+    /// @brief String representation
+    virtual std::string get_type() const override;
+
+    /// @brief Render all entry information into single string
+    virtual std::string render_to_description() const override;
+
+    //////////////////////////////////////////////////////////////////////////
+    // Byte values
+
+    /// @brief 0x04 offset
+    /// Index of the manufacturer string
+    uint8_t get_manufacturer_index() const;
+
+    /// @brief 0x05 offset
+    /// Index of the product name string
+    uint8_t get_product_name_index() const;
+
+    /// @brief 0x06 offset
+    /// Index of the product version string
+    uint8_t get_version_index() const;
+
+    /// @brief 0x07 offset
+    /// Index of the serial number string
+    uint8_t get_serial_number_index() const;
+
+    /// @brief 0x08 offset, 16 bytes
+    /// Universal unique ID number, nullptr if not provided
+    const uint8_t* get_uuid() const;
+
+    /// @brief 0x18 offset
+    /// Event that caused the system to power up
+    uint8_t get_wakeup_type() const;
+
+    /// @brief 0x19 offset
+    /// Index of the SKU number string
+    uint8_t get_sku_number_index() const;
+
+    /// @brief 0x1A offset
+    /// Index of the family string
+    uint8_t get_family_index() const;
+
+    //////////////////////////////////////////////////////////////////////////
+    // String values
+
+    /// @brief System manufacturer
+    std::string get_manufacturer_string() const;
+
+    /// @brief Product name
+    std::string get_product_name_string() const;
+
+    /// @brief Product version
+    std::string get_version_string() const;
+
+    /// @brief System serial number
+    std::string get_serial_number_string() const;
+
+    /// @brief UUID in canonical 8-4-4-4-12 form, as /sys/class/dmi/id/product_uuid shows it
+    /// Since 2.6 the first three fields are little-endian. Empty if not provided
+    std::string get_uuid_string() const;
+
+    /// @brief Wake-up type description
+    std::string get_wakeup_type_string() const;
+
+    /// @brief SKU number
+    std::string get_sku_number_string() const;
+
+    /// @brief Product family
+    std::string get_family_string() const;
+
+private:
+
+    /// Map values to string representation
+    void init_string_values();
+
+private:
+
+    /// Initialization depends on SMBIOS version
+    const SystemInformationV20* system_information20_ = nullptr;
+    const SystemInformationV21* system_information21_ = nullptr;
+    const SystemInformationV24* system_information24_ = nullptr;
+
+    /// UUID byte order depends on version
+    bool uuid_little_endian_ = true;
+
+    /// Value to string representation
+    std::map<uint8_t, std::string> wakeup_type_map_;
+};
+
+} // namespace smbios
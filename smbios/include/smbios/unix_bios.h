@@ -2,7 +2,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <vector>
-
+#include <memory>
+#include <set>
+#include <string>
+#include <smbios/smbios_entry_point.h>
+#include <smbios/smbios_acquisition.h>
 
 #if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
 
@@ -18,8 +22,19 @@ class SMBiosImpl
 public:
 
     /// @brief Read the SMBIOS table using /sys/firmware/dmi/tables
+    /// or EFI system table, if available
     SMBiosImpl();
 
+    /// @brief Read the SMBIOS table using the only source (SysFS or EFI),
+    /// other sources are not supported by this implementation and fail
+    /// All paths are taken inside the filesystem root, empty root is '/'
+    explicit SMBiosImpl(SMBiosSource source, const std::string& root_path = std::string());
+
+    /// @brief Read only structures of wanted types from /sys/firmware/dmi/entries,
+    /// table consists of these structures ordered by type and instance and the end of table marker
+    /// (empty if there are no such structures, then it is read successfully as well)
+    explicit SMBiosImpl(const std::set<uint8_t>& types, const std::string& root_path = std::string());
+
     /// @brief Make compiler happy
     ~SMBiosImpl();
 
@@ -38,30 +53,71 @@ public:
     /// @brief Minor version (from header)
     size_t get_minor_version() const;
 
+    /// @brief Raw entry point validated by the source, empty if it has not been read
+    const std::vector<uint8_t>& get_entry_point() const;
+
+    /// @brief Move the table read by the caller (physical memory scan)
     void read_from_physical_memory(std::vector<uint8_t>& physical_memory_dump);
 
+    /// @brief Read and validate only the entry point of the source (SysFS, SysFSEntries or EFI),
+    /// the table is not read or mapped
+    static bool probe_entry_point(SMBiosSource source, const std::string& root_path, SMBiosEntryPointInfo& entry_point_info);
+
 private:
 
+    /// Nothing is read, used for the entry point probe
+    explicit SMBiosImpl(const std::string& root_path);
+
+    /// Read and validate sysfs entry point into the entry point buffer
+    bool read_sysfs_entry_point(SMBiosEntryPointInfo& entry_point_info);
+
+    /// Read and validate entry point at the physical address into the entry point buffer
+    bool read_efi_entry_point(uint64_t entry_point_address, SMBiosEntryPointInfo& entry_point_info);
+
     /// Looking for SMBIOS entry point in sysfs
     bool sysfs_table_exists() const;
 
-    /// Looking for SMBIOS entry point in EFI, reading table from /dev/mem
-    bool efi_table_exists() const;
+    /// Looking for SMBIOS entry point address in EFI system table
+    /// SMBIOS3 entry is preferred over the legacy SMBIOS one
+    bool efi_entry_point_address(uint64_t& entry_point_address) const;
 
     /// Looking for SMBIOS entry point directly in /dev/mem
     //bool scan_devmem_table();
 
-    /// Found SMBIOS entry point in sysfs
-    void reading_from_sysfs();
+    /// Found SMBIOS entry point in sysfs, read entry point and the table
+    bool reading_from_sysfs();
 
-    /// Found SMBIOS entry point in EFI, reading table from /dev/mem
-    void reading_from_efi();
+    /// Read structures of wanted types one by one, version is taken from sysfs entry point if readable
+    /// @return false only if the entries could not be listed or read
+    bool reading_from_sysfs_entries(const std::set<uint8_t>& types);
 
-    /// Implementation
-    void compose_native_smbios_table();
+    /// Found SMBIOS entry point in EFI, map entry point and the table from /dev/mem
+    bool reading_from_efi(uint64_t entry_point_address);
+
+    /// Implementation, try all native sources if source is SMBiosSource::None
+    void compose_native_smbios_table(SMBiosSource source);
+
+    /// Path inside the filesystem root
+    std::string rooted_path(const std::string& path) const;
+
+    /// Filesystem root of all paths
+    std::string root_path_;
 
     /// Save table with header here
     std::vector<uint8_t> table_buffer_;
+
+    /// Raw entry point, if the source provides it
+    std::vector<uint8_t> entry_point_buffer_;
+
+    /// Validated entry point information
+    SMBiosEntryPointInfo entry_point_info_;
+
+    /// Table mapped directly from the physical memory (EFI source)
+    std::unique_ptr<PhysicalMemory> table_memory_;
+
+    /// Table inside the physical memory mapping
+    const uint8_t* mapped_table_base_ = nullptr;
+    size_t mapped_table_size_ = 0;
 };
 
 } // namespace smbios
@@ -2,6 +2,11 @@
 #include <vector>
 #include <cstdint>
 #include <memory>
+#include <set>
+#include <string>
+#include <smbios/smbios_acquisition.h>
+#include <smbios/raw_smbios_data.h>
+#include <smbios/smbios_entry_point.h>
 
 #if defined(_WIN32) || defined(_WIN64)
 
@@ -10,16 +15,6 @@ namespace smbios {
 class NativeSystemInformation;
 class PhysicalMemory;
 
-/// @brief SMBIOS header+table beginning
-struct RawSMBIOSData {
-    uint8_t calling_method;
-    uint8_t major_version;
-    uint8_t minor_version;
-    uint8_t dmi_revision;
-    uint32_t length;
-    uint8_t smbios_table_data[1];
-};
-
 /// @brief Class that owns memory allocated for SMBIOS table, offsets for table beginning
 /// (without header) and table size
 class SMBiosImpl
@@ -29,6 +24,14 @@ public:
     /// @brief Read the SMBIOS table using GetSystemFirmwareTable() 
     SMBiosImpl();
 
+    /// @brief Read the SMBIOS table using the only source,
+    /// only SMBiosSource::FirmwareTable is supported by this implementation, root is ignored
+    explicit SMBiosImpl(SMBiosSource source, const std::string& root_path = std::string());
+
+    /// @brief Per-type structures are not exported by Windows, nothing is read
+    /// so that caller falls back to the whole table
+    explicit SMBiosImpl(const std::set<uint8_t>& types, const std::string& root_path = std::string());
+
     /// @brief Make compiler happy
     ~SMBiosImpl();
 
@@ -50,9 +53,16 @@ public:
     /// @brief Minor version (from header)
     size_t get_minor_version() const;
 
+    /// @brief Firmware table has no entry point, always empty
+    const std::vector<uint8_t>& get_entry_point() const;
+
     /// @brief Read from memory dump, it is intentionally left non-const to be moved
     void read_from_physical_memory(std::vector<uint8_t>& physical_memory_dump);
 
+    /// @brief Version and table length of SMBiosSource::FirmwareTable, root is ignored
+    /// Firmware table has no entry point, so anchor type is SMBiosAnchorType::NoHeader
+    static bool probe_entry_point(SMBiosSource source, const std::string& root_path, SMBiosEntryPointInfo& entry_point_info);
+
 private:
 
     /// Find ntdll entry point
@@ -68,6 +78,9 @@ private:
 
     /// Apply to the table with header
     RawSMBIOSData* smbios_data_ = nullptr;
+
+    /// Firmware table has no entry point
+    std::vector<uint8_t> entry_point_buffer_;
 };
 
 } // namespace smbios
@@ -2,12 +2,15 @@
 #if defined(_WIN32) || defined(_WIN64)
 
 #include <vector>
+#include <string>
 #include <cstdint>
 #include <memory>
 
 namespace smbios {
 
 class WinHandlePtr;
+class PhysicalMemoryView;
+enum class PhysicalMemoryAccess;
 
 /// @brief Windows-specific class that map and dump raw physical memory
 /// Since Vista could be used only from kernel-mode
@@ -22,14 +25,15 @@ public:
 
     /// @brief Create mapping with provided base offset and size
     /// NtOpenSection()/NtMapViewOfSection() Native API calls are used
-    NativePhysicalMemory(size_t base, size_t length);
+    /// Section is always mapped, access method and filesystem root are ignored
+    NativePhysicalMemory(size_t base, size_t length, PhysicalMemoryAccess access, const std::string& root_path);
 
     /// @brief Call Unmap memory
     ~NativePhysicalMemory();
 
     /// @brief Create new mapping
     /// NtOpenSection()/NtMapViewOfSection() Native API calls are used
-    void map_physical_memory(size_t base, size_t length);
+    void map_physical_memory(size_t base, size_t length, PhysicalMemoryAccess access, const std::string& root_path);
 
     /// @brief Check whether physical memory is mapped
     bool is_mapped() const;
@@ -37,12 +41,21 @@ public:
     /// @brief Dump area of physical memory into page-aligned byte array
     std::vector<uint8_t> get_memory_dump(size_t offset, size_t length) const;
 
+    /// @brief Zero-copy view of the mapped area, offset from the requested base
+    PhysicalMemoryView get_memory_view(size_t offset, size_t length) const;
+
     /// @brief get page-aligned offset from beginning of the mapping
     uint8_t* get_memory_offset(size_t offset) const;
 
+    /// @brief Offset of the requested base from the page-aligned beginning of the mapping
+    size_t get_page_offset() const;
+
     /// @brief Unmap memory, close handles, zero pointers
     void unmap_memory();
 
+    /// @brief Mappings are not cached on Windows, nothing to release
+    static void release_cached_mappings() {}
+
 private:
 
     /// Check whether ntdll contains necessary calls (do not contain up to Vista)
@@ -56,6 +69,9 @@ private:
 
     /// System page offset
     size_t page_offset_ = 0u;
+
+    /// Requested mapping length
+    size_t mapped_length_ = 0u;
 };
 
 } // namespace smbios
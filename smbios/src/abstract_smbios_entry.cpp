@@ -26,7 +26,7 @@ void AbstractSMBiosEntry::parse_dmi_strings()
         dmi_strings_.push_back(std::string(reinterpret_cast<const char*>(string_section)));
         string_section += dmi_strings_.back().size() + 1;
         
-    } while (string_section[0] != 0 && string_section[1] != 0);
+    } while (string_section[0] != 0);
 }
 
 std::string AbstractSMBiosEntry::dmi_string(size_t string_index) const
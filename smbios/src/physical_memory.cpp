@@ -1,5 +1,7 @@
 #include <boost/iostreams/device/mapped_file.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <smbios/physical_memory.h>
 #if defined(_WIN32) || defined(_WIN64)
 #include <smbios/win_physical_memory.h>
@@ -10,13 +12,40 @@
 using namespace smbios;
 namespace boost_io = boost::iostreams;
 
+namespace {
+
+/// Entry points and typical tables are read, legacy BIOS area scan is mapped
+std::atomic<size_t> read_threshold(16 * 1024);
+
+/// Average time of access to the area using given method, including touching every page
+std::chrono::nanoseconds measure_access(size_t base, size_t length, PhysicalMemoryAccess access)
+{
+    const size_t iterations = 16;
+    volatile uint8_t sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+
+        // mapping should not be served from the cache, it would not be the first access cost
+        PhysicalMemory::release_cached_mappings();
+        PhysicalMemory memory(base, length, access);
+        PhysicalMemoryView view = memory.get_memory_view(0, length);
+        for (size_t offset = 0; offset < view.size(); offset += 4096) {
+            sink += view.data()[offset];
+        }
+    }
+    return (std::chrono::steady_clock::now() - start) / iterations;
+}
+
+} // namespace
+
 PhysicalMemory::PhysicalMemory() : native_physical_memory_(std::make_unique<NativePhysicalMemory>())
 {
 
 }
 
-PhysicalMemory::PhysicalMemory(size_t base, size_t length)
-    : native_physical_memory_(std::make_unique<NativePhysicalMemory>(base, length))
+PhysicalMemory::PhysicalMemory(size_t base, size_t length, PhysicalMemoryAccess access, const std::string& root_path)
+    : native_physical_memory_(std::make_unique<NativePhysicalMemory>(base, length, select_access(length, access), root_path))
 {
 
 }
@@ -26,13 +55,13 @@ PhysicalMemory::~PhysicalMemory()
 
 }
 
-void PhysicalMemory::map_physical_memory(size_t base, size_t length)
+void PhysicalMemory::map_physical_memory(size_t base, size_t length, PhysicalMemoryAccess access, const std::string& root_path)
 {
     if (is_mapped()) {
         unmap_memory();
     }
 
-    native_physical_memory_->map_physical_memory(base, length);
+    native_physical_memory_->map_physical_memory(base, length, select_access(length, access), root_path);
 }
 
 bool PhysicalMemory::is_mapped() const
@@ -45,12 +74,59 @@ std::vector<uint8_t> PhysicalMemory::get_memory_dump(size_t offset, size_t lengt
     return native_physical_memory_->get_memory_dump(offset, length);
 }
 
+PhysicalMemoryView PhysicalMemory::get_memory_view(size_t offset, size_t length) const
+{
+    return native_physical_memory_->get_memory_view(offset, length);
+}
+
 const uint8_t* PhysicalMemory::get_memory_offset(size_t offset) const
 {
     return native_physical_memory_->get_memory_offset(offset);
 }
 
+size_t PhysicalMemory::get_page_offset() const
+{
+    return native_physical_memory_->get_page_offset();
+}
+
 void PhysicalMemory::unmap_memory()
 {
     native_physical_memory_->unmap_memory();
 }
+
+void PhysicalMemory::release_cached_mappings()
+{
+    NativePhysicalMemory::release_cached_mappings();
+}
+
+void PhysicalMemory::set_read_threshold(size_t threshold)
+{
+    read_threshold = threshold;
+}
+
+size_t PhysicalMemory::get_read_threshold()
+{
+    return read_threshold;
+}
+
+size_t PhysicalMemory::calibrate_read_threshold(size_t base, size_t max_length)
+{
+    // the first length where mapping wins, or above the maximum if it never does
+    size_t threshold = max_length + 1;
+    for (size_t length = 64; length <= max_length; length *= 2) {
+        if (measure_access(base, length, PhysicalMemoryAccess::Map) < measure_access(base, length, PhysicalMemoryAccess::Read)) {
+            threshold = length;
+            break;
+        }
+    }
+    set_read_threshold(threshold);
+    return threshold;
+}
+
+PhysicalMemoryAccess PhysicalMemory::select_access(size_t length, PhysicalMemoryAccess access)
+{
+    if (PhysicalMemoryAccess::Auto != access) {
+        return access;
+    }
+    return (length < read_threshold) ? PhysicalMemoryAccess::Read : PhysicalMemoryAccess::Map;
+}
@@ -0,0 +1,161 @@
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+#include <smbios/posix_file.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace smbios;
+
+namespace {
+
+/// Pseudo-files without size information are read with this step
+constexpr size_t default_read_size = 4096;
+
+/// RAII for the raw file descriptor
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    ~FileDescriptor() { if (fd_ >= 0) ::close(fd_); }
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    int get() const { return fd_; }
+private:
+    int fd_ = -1;
+};
+
+/// pread() repeating on signal interruption
+ssize_t pread_retry(int fd, uint8_t* buffer, size_t length, off_t offset)
+{
+    ssize_t bytes_read = 0;
+    do {
+        bytes_read = ::pread(fd, buffer, length, offset);
+    } while (bytes_read < 0 && errno == EINTR);
+    return bytes_read;
+}
+
+} // namespace
+
+std::string smbios::make_rooted_path(const std::string& root_path, const std::string& path)
+{
+    if (root_path.empty()) {
+        return path;
+    }
+    // path is absolute, do not double the separator
+    if ('/' == root_path.back()) {
+        return root_path.substr(0, root_path.size() - 1) + path;
+    }
+    return root_path + path;
+}
+
+bool smbios::read_file_contents(const std::string& path, std::vector<uint8_t>& contents)
+{
+    FileDescriptor file(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (file.get() < 0) {
+        contents.clear();
+        return false;
+    }
+
+    struct stat file_stat = {};
+    size_t expected_size = default_read_size;
+    if ((0 == ::fstat(file.get(), &file_stat)) && (file_stat.st_size > 0)) {
+        expected_size = static_cast<size_t>(file_stat.st_size);
+    }
+
+    contents.resize(expected_size);
+    size_t total_read = 0;
+
+    while (true) {
+
+        if (total_read == contents.size()) {
+
+            // reported size has been read, make sure it was the real EOF
+            uint8_t probe[default_read_size];
+            ssize_t probe_read = pread_retry(file.get(), probe, sizeof(probe), static_cast<off_t>(total_read));
+            if (probe_read <= 0) {
+                break;
+            }
+            contents.insert(contents.end(), probe, probe + probe_read);
+            total_read += static_cast<size_t>(probe_read);
+            continue;
+        }
+
+        ssize_t bytes_read = pread_retry(file.get(), &contents[total_read],
+                                         contents.size() - total_read, static_cast<off_t>(total_read));
+        if (bytes_read < 0) {
+            contents.clear();
+            return false;
+        }
+        if (0 == bytes_read) {
+            break;
+        }
+        total_read += static_cast<size_t>(bytes_read);
+    }
+
+    contents.resize(total_read);
+    return !contents.empty();
+}
+
+bool smbios::write_file_atomically(const std::string& path, const std::vector<uint8_t>& contents)
+{
+    const std::string temp_path = path + ".tmp." + std::to_string(::getpid());
+    {
+        FileDescriptor file(::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR));
+        if (file.get() < 0) {
+            return false;
+        }
+
+        size_t total_written = 0;
+        while (total_written < contents.size()) {
+            ssize_t bytes_written = ::write(file.get(), contents.data() + total_written, contents.size() - total_written);
+            if (bytes_written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (bytes_written <= 0) {
+                ::unlink(temp_path.c_str());
+                return false;
+            }
+            total_written += static_cast<size_t>(bytes_written);
+        }
+    }
+
+    if (0 != ::rename(temp_path.c_str(), path.c_str())) {
+        ::unlink(temp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool smbios::is_private_file(const std::string& path)
+{
+    FileDescriptor file(::open(path.c_str(), O_RDONLY | O_NOFOLLOW | O_CLOEXEC));
+    struct stat file_stat = {};
+    if (file.get() < 0 || 0 != ::fstat(file.get(), &file_stat)) {
+        return false;
+    }
+    return S_ISREG(file_stat.st_mode) && file_stat.st_uid == ::geteuid()
+            && 0 == (file_stat.st_mode & (S_IWGRP | S_IWOTH));
+}
+
+bool smbios::list_directory(const std::string& path, std::vector<std::string>& names)
+{
+    names.clear();
+    DIR* directory = ::opendir(path.c_str());
+    if (nullptr == directory) {
+        return false;
+    }
+
+    while (const struct dirent* entry = ::readdir(directory)) {
+        if (0 != std::strcmp(entry->d_name, ".") && 0 != std::strcmp(entry->d_name, "..")) {
+            names.emplace_back(entry->d_name);
+        }
+    }
+    ::closedir(directory);
+    return true;
+}
+
+#endif // defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
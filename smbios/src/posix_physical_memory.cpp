@@ -1,72 +1,289 @@
 #if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
 #include <smbios/posix_physical_memory.h>
-#include <boost/iostreams/device/mapped_file.hpp>
+#include <smbios/physical_memory.h>
+#include <smbios/posix_file.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 
-namespace boost_io = boost::iostreams;
 using namespace smbios;
 
-NativePhysicalMemory::NativePhysicalMemory(size_t base, size_t length)
-    : physical_memory_map_(std::make_unique<boost::iostreams::mapped_file_source>())
+namespace {
+
+/// Physical memory device
+const char physical_memory_device[] = "/dev/mem";
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// PhysicalMemoryWindow
+
+PhysicalMemoryWindow::PhysicalMemoryWindow(int device_fd, size_t aligned_base, size_t aligned_length)
+    : base_(aligned_base), length_(aligned_length)
 {
-    map_physical_memory(base, length);
+    void* address = ::mmap(nullptr, aligned_length, PROT_READ, MAP_SHARED, device_fd, static_cast<off_t>(aligned_base));
+    if (MAP_FAILED == address) {
+        throw std::system_error(errno, std::system_category(), "Unable to map physical memory");
+    }
+    address_ = static_cast<const uint8_t*>(address);
 }
 
-NativePhysicalMemory::NativePhysicalMemory()
-    : physical_memory_map_(std::make_unique<boost::iostreams::mapped_file_source>())
+PhysicalMemoryWindow::~PhysicalMemoryWindow()
 {
+    ::munmap(const_cast<uint8_t*>(address_), length_);
 }
 
-NativePhysicalMemory::~NativePhysicalMemory()
+bool PhysicalMemoryWindow::contains(size_t base, size_t length) const
+{
+    return (base >= base_) && (base + length <= base_ + length_);
+}
+
+bool PhysicalMemoryWindow::overlaps(size_t base, size_t length) const
+{
+    return (base < base_ + length_) && (base_ < base + length);
+}
+
+const uint8_t* PhysicalMemoryWindow::address_of(size_t physical_address) const
+{
+    return address_ + (physical_address - base_);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// PhysicalMemoryPool
+
+std::mutex PhysicalMemoryPool::pools_lock_;
+std::map<std::string, std::unique_ptr<PhysicalMemoryPool>> PhysicalMemoryPool::pools_;
+
+PhysicalMemoryPool::PhysicalMemoryPool(const std::string& device_path) : device_path_(device_path)
+{
+}
+
+PhysicalMemoryPool& PhysicalMemoryPool::instance(const std::string& root_path)
 {
+    const std::string device_path = make_rooted_path(root_path, physical_memory_device);
 
+    std::lock_guard<std::mutex> lock(pools_lock_);
+    std::unique_ptr<PhysicalMemoryPool>& pool = pools_[device_path];
+    if (!pool) {
+        pool.reset(new PhysicalMemoryPool(device_path));
+    }
+    return *pool;
+}
+
+void PhysicalMemoryPool::release_all_unused()
+{
+    std::lock_guard<std::mutex> lock(pools_lock_);
+    for (auto& pool : pools_) {
+        pool.second->release_unused();
+    }
 }
 
-void NativePhysicalMemory::map_physical_memory(size_t base, size_t length)
+PhysicalMemoryPool::~PhysicalMemoryPool()
+{
+    release_unused();
+    if (device_fd_ >= 0) {
+        ::close(device_fd_);
+    }
+}
+
+size_t PhysicalMemoryPool::page_size()
 {
 #ifdef _SC_PAGESIZE
-    size_t mempry_page_offset = base % sysconf(_SC_PAGESIZE);
+    static const size_t system_page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
 #else
-    size_t mempry_page_offset = base % getpagesize();
+    static const size_t system_page_size = static_cast<size_t>(getpagesize());
 #endif /* _SC_PAGESIZE */
+    return system_page_size;
+}
+
+int PhysicalMemoryPool::device_descriptor()
+{
+    if (device_fd_ < 0) {
+        device_fd_ = ::open(device_path_.c_str(), O_RDONLY | O_CLOEXEC);
+        if (device_fd_ < 0) {
+            throw std::system_error(errno, std::system_category(), "Unable to open physical memory device");
+        }
+    }
+    return device_fd_;
+}
+
+std::shared_ptr<const PhysicalMemoryWindow> PhysicalMemoryPool::acquire(size_t base, size_t length)
+{
+    std::lock_guard<std::mutex> lock(pool_lock_);
+
+    // the most recently used window is checked first
+    for (auto it = windows_.rbegin(); it != windows_.rend(); ++it) {
+        if ((*it)->contains(base, length)) {
+            std::shared_ptr<PhysicalMemoryWindow> window = *it;
+            windows_.erase(std::next(it).base());
+            windows_.push_back(window);
+            return window;
+        }
+    }
+
+    // cover both requested area and cached windows it overlaps, so that they could be replaced
+    size_t aligned_begin = base - (base % page_size());
+    size_t aligned_end = base + std::max<size_t>(length, 1);
+    for (const std::shared_ptr<PhysicalMemoryWindow>& window : windows_) {
+        if (window->overlaps(base, length)) {
+            aligned_begin = std::min(aligned_begin, window->base());
+            aligned_end = std::max(aligned_end, window->base() + window->length());
+        }
+    }
+    aligned_end = ((aligned_end + page_size() - 1) / page_size()) * page_size();
+
+    auto window = std::make_shared<PhysicalMemoryWindow>(device_descriptor(), aligned_begin, aligned_end - aligned_begin);
+
+    // overlapped windows stay mapped while someone uses them, but they are not cached anymore
+    windows_.erase(std::remove_if(windows_.begin(), windows_.end(),
+                                  [&window](const std::shared_ptr<PhysicalMemoryWindow>& cached) {
+                                      return window->contains(cached->base(), cached->length());
+                                  }),
+                   windows_.end());
+    windows_.push_back(window);
+    evict_unused();
+    return window;
+}
+
+void PhysicalMemoryPool::read(size_t base, size_t length, uint8_t* buffer)
+{
+    int device_fd = -1;
+    {
+        std::lock_guard<std::mutex> lock(pool_lock_);
+        device_fd = device_descriptor();
+    }
+
+    size_t total_read = 0;
+    while (total_read < length) {
+        ssize_t bytes_read = ::pread(device_fd, buffer + total_read, length - total_read,
+                                     static_cast<off_t>(base + total_read));
+        if (bytes_read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes_read <= 0) {
+            throw std::system_error(bytes_read < 0 ? errno : EIO, std::system_category(),
+                                    "Unable to read physical memory");
+        }
+        total_read += static_cast<size_t>(bytes_read);
+    }
+}
+
+void PhysicalMemoryPool::release_unused()
+{
+    std::lock_guard<std::mutex> lock(pool_lock_);
+
+    windows_.erase(std::remove_if(windows_.begin(), windows_.end(),
+                                  [](const std::shared_ptr<PhysicalMemoryWindow>& cached) {
+                                      return cached.use_count() == 1;
+                                  }),
+                   windows_.end());
+}
+
+void PhysicalMemoryPool::evict_unused()
+{
+    for (auto it = windows_.begin(); it != windows_.end() && windows_.size() > max_cached_windows_;) {
+        if (it->use_count() == 1) {
+            it = windows_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// NativePhysicalMemory
+
+NativePhysicalMemory::NativePhysicalMemory(size_t base, size_t length, PhysicalMemoryAccess access,
+                                           const std::string& root_path)
+{
+    map_physical_memory(base, length, access, root_path);
+}
+
+NativePhysicalMemory::NativePhysicalMemory()
+{
+}
+
+NativePhysicalMemory::~NativePhysicalMemory()
+{
+
+}
+
+void NativePhysicalMemory::map_physical_memory(size_t base, size_t length, PhysicalMemoryAccess access,
+                                               const std::string& root_path)
+{
+    PhysicalMemoryPool& pool = PhysicalMemoryPool::instance(root_path);
+    size_t mempry_page_offset = base % PhysicalMemoryPool::page_size();
 
-    boost_io::mapped_file_params params = {};
-    params.path = "/dev/mem";
-    params.flags = boost_io::mapped_file::mapmode::readonly;
-    params.length = length + mempry_page_offset;
-    params.offset = base - mempry_page_offset;
-    params.hint = nullptr;
     // TODO: process exception higher
-    physical_memory_map_->open(params);
+    if (PhysicalMemoryAccess::Read == access) {
+        // keep page-aligned layout, so that offsets mean the same for both access methods
+        read_buffer_.resize(length + mempry_page_offset);
+        pool.read(base - mempry_page_offset, read_buffer_.size(), read_buffer_.data());
+        window_.reset();
+        mapping_begin_ = read_buffer_.data();
+    }
+    else {
+        window_ = pool.acquire(base, length);
+        read_buffer_.clear();
+        mapping_begin_ = window_->address_of(base - mempry_page_offset);
+    }
+    mapping_length_ = length + mempry_page_offset;
+    page_offset_ = mempry_page_offset;
 }
 
 bool NativePhysicalMemory::is_mapped() const
 {
-    return physical_memory_map_ && physical_memory_map_->is_open();
+    return nullptr != mapping_begin_;
 }
 
 std::vector<uint8_t> NativePhysicalMemory::get_memory_dump(size_t offset, size_t length) const
 {
-    if ((offset + length) > physical_memory_map_->size()) {
+    if (!is_mapped() || (offset + length) > mapping_length_) {
         return std::vector<uint8_t>();
     }
 
-    std::vector<uint8_t> memory_dump(length);
-    const uint8_t* dump_start = reinterpret_cast<const uint8_t*>(physical_memory_map_->data()) + offset;
+    const uint8_t* dump_start = mapping_begin_ + offset;
     const uint8_t* dump_end = dump_start + length;
-    memory_dump.assign(dump_start, dump_end);
-    return std::move(memory_dump);
+    return std::vector<uint8_t>(dump_start, dump_end);
+}
+
+PhysicalMemoryView NativePhysicalMemory::get_memory_view(size_t offset, size_t length) const
+{
+    if (!is_mapped() || (page_offset_ + offset + length) > mapping_length_) {
+        return PhysicalMemoryView();
+    }
+    return PhysicalMemoryView(mapping_begin_ + page_offset_ + offset, length);
 }
 
 const uint8_t* NativePhysicalMemory::get_memory_offset(size_t offset) const
 {
-    return reinterpret_cast<const uint8_t*>(physical_memory_map_->data() + offset);
+    return mapping_begin_ + offset;
+}
+
+size_t NativePhysicalMemory::get_page_offset() const
+{
+    return page_offset_;
 }
 
 void NativePhysicalMemory::unmap_memory()
 {
-    if (physical_memory_map_->is_open()) {
-        physical_memory_map_->close();
-    }
+    // window stays cached in the pool
+    window_.reset();
+    read_buffer_.clear();
+    read_buffer_.shrink_to_fit();
+    mapping_begin_ = nullptr;
+    mapping_length_ = 0u;
+    page_offset_ = 0u;
+}
+
+void NativePhysicalMemory::release_cached_mappings()
+{
+    PhysicalMemoryPool::release_all_unused();
 }
 
-#endif
+#endif // defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
@@ -0,0 +1,33 @@
+#include <smbios/raw_smbios_data.h>
+
+#include <cstddef>
+
+using namespace smbios;
+
+static_assert(offsetof(RawSMBIOSData, smbios_table_data) == raw_smbios_data_header_size,
+              "Raw SMBIOS data header should be 8 bytes");
+
+bool smbios::parse_raw_smbios_data(const uint8_t* data, size_t length, RawSMBiosDataInfo& info)
+{
+    if (nullptr == data || length < raw_smbios_data_header_size) {
+        return false;
+    }
+
+    const RawSMBIOSData* raw_data = reinterpret_cast<const RawSMBIOSData*>(data);
+    if (2 != raw_data->major_version && 3 != raw_data->major_version) {
+        return false;
+    }
+
+    // table should contain at least one structure header
+    const size_t table_length = raw_data->length;
+    if (table_length < 4 || table_length > length - raw_smbios_data_header_size) {
+        return false;
+    }
+
+    info.major_version = raw_data->major_version;
+    info.minor_version = raw_data->minor_version;
+    info.dmi_revision = raw_data->dmi_revision;
+    info.table = data + raw_smbios_data_header_size;
+    info.table_length = table_length;
+    return true;
+}
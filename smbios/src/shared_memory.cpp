@@ -0,0 +1,143 @@
+#include <smbios/shared_memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <system_error>
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace smbios;
+
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+
+namespace {
+
+/// Signature size, written after the rest of contents
+constexpr size_t signature_size = 8;
+
+/// RAII for the shared memory descriptor
+class SharedMemoryDescriptor {
+public:
+    explicit SharedMemoryDescriptor(int fd) : fd_(fd) {}
+    ~SharedMemoryDescriptor() { if (fd_ >= 0) ::close(fd_); }
+    SharedMemoryDescriptor(const SharedMemoryDescriptor&) = delete;
+    SharedMemoryDescriptor& operator=(const SharedMemoryDescriptor&) = delete;
+    int get() const { return fd_; }
+private:
+    int fd_ = -1;
+};
+
+std::system_error shared_memory_error(const std::string& what, const std::string& name)
+{
+    return std::system_error(errno, std::system_category(), what + " shared memory " + name);
+}
+
+} // namespace
+
+SharedMemorySegment::SharedMemorySegment(const std::string& name)
+{
+    SharedMemoryDescriptor segment(::shm_open(name.c_str(), O_RDONLY, 0));
+    if (segment.get() < 0) {
+        throw shared_memory_error("Unable to open", name);
+    }
+
+    struct stat segment_stat = {};
+    if (0 != ::fstat(segment.get(), &segment_stat)) {
+        throw shared_memory_error("Unable to stat", name);
+    }
+    if (segment_stat.st_size <= 0) {
+        errno = ENODATA;
+        throw shared_memory_error("Empty", name);
+    }
+
+    size_t segment_size = static_cast<size_t>(segment_stat.st_size);
+    void* mapping = ::mmap(nullptr, segment_size, PROT_READ, MAP_SHARED, segment.get(), 0);
+    if (MAP_FAILED == mapping) {
+        throw shared_memory_error("Unable to map", name);
+    }
+    data_ = static_cast<const uint8_t*>(mapping);
+    size_ = segment_size;
+}
+
+SharedMemorySegment::~SharedMemorySegment()
+{
+    if (data_) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+}
+
+void SharedMemorySegment::publish(const std::string& name, const std::vector<uint8_t>& contents)
+{
+    if (contents.empty()) {
+        errno = EINVAL;
+        throw shared_memory_error("Nothing to publish in", name);
+    }
+
+    // new segment: mappings of the previous one are not changed under readers
+    ::shm_unlink(name.c_str());
+    SharedMemoryDescriptor segment(::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IRGRP | S_IROTH));
+    if (segment.get() < 0) {
+        throw shared_memory_error("Unable to create", name);
+    }
+    // process umask should not hide the segment from readers
+    ::fchmod(segment.get(), S_IRUSR | S_IRGRP | S_IROTH);
+
+    if (0 != ::ftruncate(segment.get(), static_cast<off_t>(contents.size()))) {
+        throw shared_memory_error("Unable to size", name);
+    }
+
+    void* mapping = ::mmap(nullptr, contents.size(), PROT_READ | PROT_WRITE, MAP_SHARED, segment.get(), 0);
+    if (MAP_FAILED == mapping) {
+        throw shared_memory_error("Unable to map", name);
+    }
+
+    uint8_t* segment_data = static_cast<uint8_t*>(mapping);
+    const size_t head_size = std::min(signature_size, contents.size());
+    std::copy(contents.begin() + head_size, contents.end(), segment_data + head_size);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::copy(contents.begin(), contents.begin() + head_size, segment_data);
+    ::munmap(mapping, contents.size());
+}
+
+bool SharedMemorySegment::remove(const std::string& name)
+{
+    return 0 == ::shm_unlink(name.c_str());
+}
+
+#else
+
+SharedMemorySegment::SharedMemorySegment(const std::string&)
+{
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "POSIX shared memory");
+}
+
+SharedMemorySegment::~SharedMemorySegment()
+{
+}
+
+void SharedMemorySegment::publish(const std::string&, const std::vector<uint8_t>&)
+{
+    throw std::system_error(std::make_error_code(std::errc::function_not_supported), "POSIX shared memory");
+}
+
+bool SharedMemorySegment::remove(const std::string&)
+{
+    return false;
+}
+
+#endif
+
+const uint8_t* SharedMemorySegment::data() const
+{
+    return data_;
+}
+
+size_t SharedMemorySegment::size() const
+{
+    return size_;
+}
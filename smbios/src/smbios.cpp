@@ -2,13 +2,26 @@
 #include <smbios/win_bios.h>
 #else
 #include <smbios/unix_bios.h>
+#include <smbios/posix_file.h>
 #endif
 
 #include <limits>
 #include <algorithm>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <smbios/smbios.h>
 #include <smbios/smbios_anchor.h>
+#include <smbios/smbios_entry_point.h>
+#include <smbios/smbios_anchor_scanner.h>
+#include <smbios/raw_smbios_data.h>
+#include <smbios/smbios_snapshot.h>
+#include <smbios/smbios_cache.h>
+#include <smbios/shared_memory.h>
 #include <smbios/physical_memory.h>
 
 // DEBUG
@@ -17,6 +30,108 @@
 using std::numeric_limits;
 using namespace smbios;
 
+namespace {
+
+typedef std::chrono::steady_clock acquisition_clock;
+
+/// Index capacity reserved when the entry point does not provide the structures count
+constexpr size_t max_reserved_headers = 4096;
+
+std::chrono::microseconds elapsed_since(acquisition_clock::time_point start)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(acquisition_clock::now() - start);
+}
+
+/// Entry point of the snapshot, or its version if the source has not provided the entry point
+bool probe_snapshot(const uint8_t* snapshot, size_t snapshot_size, SMBiosEntryPointInfo& entry_point_info)
+{
+    SMBiosSnapshotInfo snapshot_info;
+    if (!parse_smbios_snapshot(snapshot, snapshot_size, snapshot_info)) {
+        return false;
+    }
+    if (!snapshot_info.entry_point
+            || !parse_smbios_entry_point(snapshot_info.entry_point, snapshot_info.entry_point_length, entry_point_info)) {
+        entry_point_info = SMBiosEntryPointInfo{};
+        entry_point_info.major_version = snapshot_info.major_version;
+        entry_point_info.minor_version = snapshot_info.minor_version;
+        entry_point_info.structures_number = snapshot_info.structures_count;
+    }
+    entry_point_info.table_length = snapshot_info.table_length;
+    return true;
+}
+
+/// Process-wide table, see SMBios::instance()
+std::mutex instance_lock;
+std::shared_ptr<const SMBios> shared_instance;
+
+/// How often cancellation is checked while the source is being read
+const std::chrono::milliseconds cancellation_check_interval{10};
+
+bool is_cancelled(const AcquisitionPolicy& policy)
+{
+    return policy.cancel_flag && policy.cancel_flag->load();
+}
+
+/// Wait for the source within the budget (zero is no limit), checking cancellation if it is possible
+/// @return false if the budget is over
+template <typename ResultType>
+bool wait_for_source(std::future<ResultType>& result, std::chrono::milliseconds budget, const AcquisitionPolicy& policy)
+{
+    if (!policy.cancel_flag) {
+        return std::future_status::ready == result.wait_for(budget);
+    }
+
+    const acquisition_clock::time_point wait_start = acquisition_clock::now();
+    for (;;) {
+        if (is_cancelled(policy)) {
+            throw std::runtime_error("SMBIOS acquisition has been cancelled");
+        }
+        std::chrono::milliseconds wait_slice = cancellation_check_interval;
+        if (budget.count()) {
+            std::chrono::milliseconds time_left = budget
+                    - std::chrono::duration_cast<std::chrono::milliseconds>(acquisition_clock::now() - wait_start);
+            if (time_left.count() <= 0) {
+                return false;
+            }
+            wait_slice = std::min(wait_slice, time_left);
+        }
+        if (std::future_status::ready == result.wait_for(wait_slice)) {
+            return true;
+        }
+    }
+}
+
+/// Structures count (with end of table marker) and the largest structure size
+struct TableLayout
+{
+    size_t structures_number = 0;
+    size_t max_structure_size = 0;
+};
+
+TableLayout get_table_layout(const uint8_t* table, size_t table_size)
+{
+    TableLayout layout;
+    const uint8_t* offset = table;
+    const uint8_t* end_table = table + table_size;
+    while (offset + 4 <= end_table && offset[1] >= 4) {
+        const uint8_t* structure_begin = offset;
+        const bool end_of_table = (SMBios::EndOfTable == offset[0]);
+        offset += offset[1];
+        while ((offset + 1 < end_table) && (offset[0] != 0 || offset[1] != 0)) {
+            offset++;
+        }
+        offset += 2;
+        layout.structures_number++;
+        layout.max_structure_size = std::max(layout.max_structure_size, static_cast<size_t>(offset - structure_begin));
+        if (end_of_table) {
+            break;
+        }
+    }
+    return layout;
+}
+
+} // namespace
+
 bool smbios::operator>(const SMBiosVersion& lhs, const SMBiosVersion& rhs)
 {
     if (lhs.major_version > rhs.major_version) {
@@ -40,63 +155,498 @@ bool smbios::operator<(const SMBiosVersion& lhs, const SMBiosVersion& rhs)
 }
 
 
-SMBios::SMBios() : native_impl_(std::make_unique<SMBiosImpl>())
+SMBios::SMBios() : SMBios(AcquisitionPolicy{})
+{
+}
+
+SMBios::SMBios(const AcquisitionPolicy& policy)
 {
     static_assert(sizeof(uint8_t) == 1, "Very strange uint8_t size");
     static_assert(sizeof(uint16_t) == 2, "Very strange uint16_t size");
     static_assert(sizeof(uint32_t) == 4, "Very strange uint32_t size");
 
-    // no one of system sources was successful, fallback to physical memory device scan
-    if (!native_impl_->smbios_read_success()) {
+    // boot cache is mapped with the index, firmware is not read
+    SMBiosEntryPointInfo probed_entry_point;
+    const std::string cache_path = get_boot_cache_path(policy, probed_entry_point);
+    if (!cache_path.empty() && read_boot_cache(cache_path, probed_entry_point)) {
+        return;
+    }
 
-        // call physical memory
-        smbios::PhysicalMemory physical_memory_device;
+    acquire(policy);
+    if (policy.lazy_indexing && cache_path.empty()) {
+        index_once_ = std::make_unique<std::once_flag>();
+    }
+    else {
+        read_smbios_table();
+    }
+
+    if (!cache_path.empty()) {
+        // cache is optional, object is usable if it could not be written
+        store_boot_cache(cache_path, make_snapshot());
+    }
+}
 
-        // read service memory
-        physical_memory_device.map_physical_memory(devmem_base_, devmem_length_);
+std::future<SMBios> SMBios::create_async(const AcquisitionPolicy& policy)
+{
+    // detached thread: dropped future does not wait for the abandoned acquisition
+    std::packaged_task<SMBios()> task([policy]() {
+        return SMBios(policy);
+    });
+    std::future<SMBios> result = task.get_future();
+    std::thread(std::move(task)).detach();
+    return result;
+}
 
-        std::vector<uint8_t> devmem_array = physical_memory_device.get_memory_dump(0, devmem_length_);
+void SMBios::create_async(const AcquisitionPolicy& policy, CreationCallback callback)
+{
+    std::thread([policy, callback]() {
+        std::unique_ptr<SMBios> smbios;
+        std::exception_ptr error;
+        try {
+            smbios.reset(new SMBios(policy));
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        callback(std::move(smbios), error);
+    }).detach();
+}
 
-        // scan for headers
-        scan_physical_memory(devmem_array);
+SMBios::SMBios(const std::set<uint8_t>& types, const std::string& root_path)
+    : native_impl_(std::make_unique<SMBiosImpl>(types, root_path))
+{
+    if (native_impl_->smbios_read_success()) {
+        table_base_ = native_impl_->get_table_base();
+        table_size_ = native_impl_->get_table_size();
+        acquisition_report_.source = SMBiosSource::SysFSEntries;
+        read_native_entry_point();
+        read_smbios_table();
+        headers_list_.erase(std::remove_if(headers_list_.begin(), headers_list_.end(),
+                                           [&types](const DMIHeader& header) { return 0 == types.count(header.type); }),
+                            headers_list_.end());
+    }
+    else {
+        // the whole table is walked once, only wanted types are indexed
+        AcquisitionPolicy policy;
+        policy.root_path = root_path;
+        policy.lazy_indexing = true;
+        *this = SMBios(policy);
+        index_once_.reset();
+        headers_list_ = find_structures(types);
+    }
+    structures_count_ = headers_list_.size();
+    count_structure_types();
+}
 
-        // What version do we have (TODO: with some workaround)
-        extract_dmi_version();
+SMBios::SMBios(const std::string& dump_file_path, const SMBiosVersion& dump_version)
+{
+    map_dump_file(dump_file_path, dump_version);
+    acquisition_report_.source = SMBiosSource::DumpFile;
+    read_smbios_table();
+}
 
-        size_t smbios_base{};
-        size_t smbios_table_length{};
+SMBios::SMBios(const uint8_t* table, size_t table_size, const uint8_t* entry_point, size_t entry_point_size)
+{
+    if (nullptr == table || 0 == table_size) {
+        throw std::runtime_error("SMBIOS table is empty");
+    }
 
-        if(smbios_entry32_ && checksum_validated_){
-            smbios_base = smbios_entry32_->structure_table_address;
-            smbios_table_length = smbios_entry32_->structure_table_length;
-        }
+    if (entry_point && !read_entry_point(entry_point, entry_point_size)) {
+        throw std::runtime_error("SMBIOS entry point is broken");
+    }
 
-        if(smbios_entry64_ && checksum_validated_){
-            smbios_base = smbios_entry64_->structure_table_address;
-            smbios_table_length = smbios_entry64_->max_structure_size;
-        }
-        smbios::PhysicalMemory smbios_physical_memory;
-        smbios_physical_memory.map_physical_memory(smbios_base, smbios_table_length);
-        std::vector<uint8_t> dump = smbios_physical_memory.get_memory_dump(0, smbios_table_length);
-        native_impl_->read_from_physical_memory(dump);
+    table_base_ = table;
+    table_size_ = table_size;
+    acquisition_report_.source = SMBiosSource::Memory;
+    read_smbios_table();
+}
+
+SMBios SMBios::from_raw_smbios_data(const uint8_t* raw_data, size_t raw_data_size)
+{
+    RawSMBiosDataInfo raw_data_info;
+    if (!parse_raw_smbios_data(raw_data, raw_data_size, raw_data_info)) {
+        throw std::runtime_error("Raw SMBIOS data header is not recognized");
     }
-    else{
+
+    SMBios smbios(raw_data_info.table, raw_data_info.table_length);
+    smbios.major_version_ = raw_data_info.major_version;
+    smbios.minor_version_ = raw_data_info.minor_version;
+    return smbios;
+}
+
+SMBios::SMBios(SMBiosSource source, const AcquisitionPolicy& policy)
+{
+    switch (source) {
+    case SMBiosSource::FirmwareTable:
+    case SMBiosSource::SysFS:
+    case SMBiosSource::EFI:
+        native_impl_ = std::make_unique<SMBiosImpl>(source, policy.root_path);
+        if (!native_impl_->smbios_read_success()) {
+            throw std::runtime_error("SMBIOS table is not available");
+        }
         // no need to validate checksum, performed by native implementation
         checksum_validated_ = true;
-    }
+        table_base_ = native_impl_->get_table_base();
+        table_size_ = native_impl_->get_table_size();
+        read_native_entry_point();
+        break;
 
-    read_smbios_table();
+    case SMBiosSource::PhysicalMemoryScan:
+        read_from_physical_memory(policy.root_path);
+        break;
+
+    case SMBiosSource::DumpFile:
+        map_dump_file(policy.dump_file_path, SMBiosVersion{policy.dump_major_version, policy.dump_minor_version});
+        break;
+
+    case SMBiosSource::SharedMemory:
+        attach_shared_memory(policy.shared_memory_name);
+        break;
+
+    default:
+        throw std::runtime_error("SMBIOS source is not supported by acquisition policy");
+    }
+    acquisition_report_.source = source;
 }
 
 SMBios::~SMBios()
 {
 }
 
+SMBios::SMBios(SMBios&&) = default;
+
+SMBios& SMBios::operator=(SMBios&&) = default;
+
+const AcquisitionReport& SMBios::get_acquisition_report() const
+{
+    return acquisition_report_;
+}
+
+void SMBios::acquire(const AcquisitionPolicy& policy)
+{
+    const acquisition_clock::time_point chain_start = acquisition_clock::now();
+    AcquisitionReport report;
+    std::unique_ptr<SMBios> acquired;
+    std::string errors;
+
+    for (const AcquisitionStep& step : policy.steps) {
+
+        if (is_cancelled(policy)) {
+            throw std::runtime_error("SMBIOS acquisition has been cancelled");
+        }
+
+        AcquisitionAttempt attempt;
+        attempt.source = step.source;
+
+        // step budget is cut to the time left before the deadline
+        std::chrono::milliseconds budget = step.budget;
+        if (policy.deadline.count()) {
+            std::chrono::milliseconds time_left = policy.deadline
+                    - std::chrono::duration_cast<std::chrono::milliseconds>(acquisition_clock::now() - chain_start);
+            if (time_left.count() <= 0) {
+                attempt.result = AcquisitionResult::Skipped;
+                report.attempts.push_back(attempt);
+                continue;
+            }
+            budget = budget.count() ? std::min(budget, time_left) : time_left;
+        }
+
+        const acquisition_clock::time_point attempt_start = acquisition_clock::now();
+        try {
+            if (0 == budget.count() && !policy.cancel_flag) {
+                acquired.reset(new SMBios(step.source, policy));
+            }
+            else {
+                // source could hang (e.g. /dev/mem access on some hypervisors), so it is read
+                // by the detached thread and abandoned if it has not finished in time or cancelled
+                const SMBiosSource source = step.source;
+                std::packaged_task<std::unique_ptr<SMBios>()> task([source, policy]() {
+                    return std::unique_ptr<SMBios>(new SMBios(source, policy));
+                });
+                std::future<std::unique_ptr<SMBios>> result = task.get_future();
+                std::thread(std::move(task)).detach();
+
+                if (wait_for_source(result, budget, policy)) {
+                    acquired = result.get();
+                }
+                else {
+                    attempt.result = AcquisitionResult::TimedOut;
+                    attempt.error = "timed out";
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            attempt.result = AcquisitionResult::Failed;
+            attempt.error = e.what();
+        }
+
+        attempt.latency = elapsed_since(attempt_start);
+        if (acquired) {
+            attempt.result = AcquisitionResult::Success;
+            report.attempts.push_back(attempt);
+            break;
+        }
+        errors += std::string(errors.empty() ? "" : "; ") + get_source_name(step.source) + ": " + attempt.error;
+        report.attempts.push_back(attempt);
+    }
+
+    report.total_latency = elapsed_since(chain_start);
+    if (!acquired) {
+        throw std::runtime_error("SMBIOS table has not been acquired from any source (" + errors + ")");
+    }
+
+    // table memory is owned by the source object, so it stays in place
+    *this = std::move(*acquired);
+    report.source = acquisition_report_.source;
+    report.snapshot_source = acquisition_report_.snapshot_source;
+    acquisition_report_ = std::move(report);
+}
+
+std::shared_ptr<const SMBios> SMBios::instance()
+{
+    std::lock_guard<std::mutex> lock(instance_lock);
+    if (!shared_instance) {
+        shared_instance = std::make_shared<const SMBios>();
+    }
+    return shared_instance;
+}
+
+std::shared_ptr<const SMBios> SMBios::refresh_instance(const AcquisitionPolicy& policy)
+{
+    // consumers are not blocked while the table is acquired
+    std::shared_ptr<const SMBios> refreshed = std::make_shared<const SMBios>(policy);
+    std::lock_guard<std::mutex> lock(instance_lock);
+    shared_instance = refreshed;
+    return refreshed;
+}
+
+SMBiosProbe SMBios::probe(const AcquisitionPolicy& policy)
+{
+    std::string errors;
+    for (const AcquisitionStep& step : policy.steps) {
+
+        if (is_cancelled(policy)) {
+            throw std::runtime_error("SMBIOS probe has been cancelled");
+        }
+
+        SMBiosProbe probe_result;
+        probe_result.source = step.source;
+        try {
+            if (probe_source(step.source, policy, probe_result.entry_point)) {
+                return probe_result;
+            }
+            errors += std::string(errors.empty() ? "" : "; ") + get_source_name(step.source) + ": not available";
+        }
+        catch (const std::exception& e) {
+            errors += std::string(errors.empty() ? "" : "; ") + get_source_name(step.source) + ": " + e.what();
+        }
+    }
+    throw std::runtime_error("SMBIOS entry point has not been probed from any source (" + errors + ")");
+}
+
+bool SMBios::probe_source(SMBiosSource source, const AcquisitionPolicy& policy, SMBiosEntryPointInfo& entry_point_info)
+{
+    switch (source) {
+    case SMBiosSource::FirmwareTable:
+    case SMBiosSource::SysFS:
+    case SMBiosSource::SysFSEntries:
+    case SMBiosSource::EFI:
+        return SMBiosImpl::probe_entry_point(source, policy.root_path, entry_point_info);
+
+    case SMBiosSource::PhysicalMemoryScan: {
+        smbios::PhysicalMemory physical_memory_device(devmem_base_, devmem_length_, PhysicalMemoryAccess::Auto, policy.root_path);
+        PhysicalMemoryView devmem_area = physical_memory_device.get_memory_view(0, devmem_length_);
+        SMBiosScanResult scan_result = scan_smbios_entry_point(devmem_area.data(), devmem_area.size());
+        if (nullptr == scan_result.entry_point) {
+            return false;
+        }
+        entry_point_info = scan_result.info;
+        return true;
+    }
+
+    case SMBiosSource::DumpFile:
+        return probe_dump_file(policy, entry_point_info);
+
+    case SMBiosSource::SharedMemory: {
+        SharedMemorySegment shared_memory(policy.shared_memory_name);
+        return probe_snapshot(shared_memory.data(), shared_memory.size(), entry_point_info);
+    }
+
+    default:
+        return false;
+    }
+}
+
+bool SMBios::probe_dump_file(const AcquisitionPolicy& policy, SMBiosEntryPointInfo& entry_point_info)
+{
+    // only the pages of the header are touched
+    boost::iostreams::mapped_file_source dump_file(policy.dump_file_path);
+    const uint8_t* dump_begin = reinterpret_cast<const uint8_t*>(dump_file.data());
+    const size_t dump_size = dump_file.size();
+    if (0 == dump_size) {
+        return false;
+    }
+
+    if (probe_snapshot(dump_begin, dump_size, entry_point_info)) {
+        return true;
+    }
+
+    // dmidecode --dump-bin
+    if (parse_smbios_entry_point(dump_begin, dump_size, entry_point_info)) {
+        return true;
+    }
+
+    entry_point_info = SMBiosEntryPointInfo{};
+    RawSMBiosDataInfo raw_data_info;
+    if (parse_raw_smbios_data(dump_begin, dump_size, raw_data_info)) {
+        entry_point_info.major_version = raw_data_info.major_version;
+        entry_point_info.minor_version = raw_data_info.minor_version;
+        entry_point_info.table_length = raw_data_info.table_length;
+        return true;
+    }
+
+    entry_point_info.major_version = policy.dump_major_version;
+    entry_point_info.minor_version = policy.dump_minor_version;
+    entry_point_info.table_length = dump_size;
+    return true;
+}
+
+void SMBios::map_dump_file(const std::string& dump_file_path, const SMBiosVersion& dump_version)
+{
+    // throws std::ios_base::failure if file could not be mapped
+    dump_file_ = std::make_unique<boost::iostreams::mapped_file_source>();
+    dump_file_->open(dump_file_path);
+    if (0 == dump_file_->size()) {
+        throw std::runtime_error("SMBIOS dump file is empty: " + dump_file_path);
+    }
+
+    major_version_ = dump_version.major_version;
+    minor_version_ = dump_version.minor_version;
+
+    table_base_ = reinterpret_cast<const uint8_t*>(dump_file_->data());
+    table_size_ = dump_file_->size();
+
+    const uint8_t* dump_begin = table_base_;
+    const size_t dump_size = table_size_;
+
+    // snapshot (SMBios::make_snapshot) keeps the index, the table is not scanned
+    if (read_snapshot(dump_begin, dump_size)) {
+        return;
+    }
+
+    // dmidecode --dump-bin: entry point at the beginning, table address is the file offset
+    if (read_entry_point(dump_begin, dump_size)) {
+        if (entry_point_info_.table_address < dump_bin_table_offset || entry_point_info_.table_address >= dump_size) {
+            throw std::runtime_error("SMBIOS dump file table is beyond the file end: " + dump_file_path);
+        }
+        table_base_ = dump_begin + entry_point_info_.table_address;
+        // SMBIOS3 entry point has only maximum table size
+        table_size_ = std::min(entry_point_info_.table_length, static_cast<size_t>(dump_size - entry_point_info_.table_address));
+        return;
+    }
+
+    // raw SMBIOS data blob uploaded from Windows host has own header with version
+    RawSMBiosDataInfo raw_data_info;
+    if (parse_raw_smbios_data(table_base_, table_size_, raw_data_info)) {
+        major_version_ = raw_data_info.major_version;
+        minor_version_ = raw_data_info.minor_version;
+        table_base_ = raw_data_info.table;
+        table_size_ = raw_data_info.table_length;
+    }
+}
+
+void SMBios::attach_shared_memory(const std::string& name)
+{
+    // throws std::system_error if the segment is not published
+    shared_memory_ = std::make_unique<SharedMemorySegment>(name);
+    if (!read_snapshot(shared_memory_->data(), shared_memory_->size())) {
+        throw std::runtime_error("Shared memory does not contain SMBIOS snapshot: " + name);
+    }
+}
+
+void SMBios::publish_shared_memory(const std::string& name) const
+{
+    SharedMemorySegment::publish(name, make_snapshot());
+}
+
+bool SMBios::read_boot_cache(const std::string& cache_path, const SMBiosEntryPointInfo& probed_entry_point)
+{
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+    // cache directory could be shared, the file name is easy to guess
+    if (!is_private_file(cache_path)) {
+        return false;
+    }
+#endif
+
+    try {
+        SMBios cached(cache_path);
+        // cache is always a snapshot, other dump formats are not expected there
+        if (SMBiosSource::None == cached.acquisition_report_.snapshot_source) {
+            return false;
+        }
+
+        // file name keeps only the checksum byte, compare the whole entry point
+        const SMBiosEntryPointInfo& cached_entry_point = cached.entry_point_info_;
+        if (cached_entry_point.anchor_type != probed_entry_point.anchor_type
+                || cached_entry_point.major_version != probed_entry_point.major_version
+                || cached_entry_point.minor_version != probed_entry_point.minor_version
+                || cached_entry_point.table_address != probed_entry_point.table_address
+                || cached_entry_point.table_length != probed_entry_point.table_length
+                || cached_entry_point.structures_number != probed_entry_point.structures_number
+                || cached_entry_point.checksum != probed_entry_point.checksum) {
+            return false;
+        }
+        *this = std::move(cached);
+        acquisition_report_.source = SMBiosSource::Cache;
+        return true;
+    }
+    catch (const std::exception&) {
+        // missing or broken cache, table is acquired again
+        return false;
+    }
+}
+
+bool SMBios::read_snapshot(const uint8_t* snapshot, size_t snapshot_size)
+{
+    SMBiosSnapshotInfo snapshot_info;
+    if (!parse_smbios_snapshot(snapshot, snapshot_size, snapshot_info)) {
+        if (snapshot_size >= sizeof(smbios_snapshot_magic)
+                && std::equal(std::begin(smbios_snapshot_magic), std::end(smbios_snapshot_magic), snapshot)) {
+            throw std::runtime_error("SMBIOS snapshot is truncated or has unsupported format version");
+        }
+        return false;
+    }
+
+    if (snapshot_info.entry_point && !read_entry_point(snapshot_info.entry_point, snapshot_info.entry_point_length)) {
+        throw std::runtime_error("SMBIOS snapshot entry point is broken");
+    }
+    major_version_ = snapshot_info.major_version;
+    minor_version_ = snapshot_info.minor_version;
+    acquisition_report_.snapshot_source = snapshot_info.source;
+
+    table_base_ = snapshot_info.table;
+    table_size_ = snapshot_info.table_length;
+
+    // the only pass: pointer fixups, no table scan
+    headers_list_.resize(snapshot_info.index_count);
+    for (size_t i = 0; i < snapshot_info.index_count; ++i) {
+        const SMBiosSnapshotIndexEntry& entry = snapshot_info.index[i];
+        DMIHeader& header = headers_list_[i];
+        header.type = entry.type;
+        header.length = entry.length;
+        header.handle = entry.handle;
+        header.data = table_base_ + entry.offset;
+    }
+    structures_count_ = snapshot_info.structures_count;
+    count_structure_types();
+    return true;
+}
+
 SMBiosVersion SMBios::get_smbios_version() const
 {
     SMBiosVersion ver;
-    size_t major_version = native_impl_->get_major_version();
-    size_t minor_version = native_impl_->get_minor_version();
+    size_t major_version = native_impl_ ? native_impl_->get_major_version() : numeric_limits<size_t>::max();
+    size_t minor_version = native_impl_ ? native_impl_->get_minor_version() : numeric_limits<size_t>::max();
 
     // native implementation provides version
     if (numeric_limits<size_t>::max() != major_version && numeric_limits<size_t>::max() != minor_version) {
@@ -114,180 +664,317 @@ SMBiosVersion SMBios::get_smbios_version() const
 
 size_t SMBios::get_structures_count() const
 {
+    ensure_index();
     return structures_count_;
 }
 
+size_t SMBios::get_structures_count(uint8_t type) const
+{
+    ensure_index();
+    return type_counts_[type];
+}
+
 const uint8_t *SMBios::get_table_base() const
 {
-    if(native_impl_ && native_impl_->get_table_base()){
-        return native_impl_->get_table_base();
-    }
-    if(smbios_entry32_ && checksum_validated_){
-        // convert from intptr_t
-        return reinterpret_cast<uint8_t *>(smbios_entry32_->structure_table_address);
-    }
-    if(smbios_entry64_ && checksum_validated_){
-        // convert from intptr_t
-        return reinterpret_cast<uint8_t *>(smbios_entry64_->structure_table_address);
-    }
-    return nullptr;
+    return table_base_;
 }
 
 size_t SMBios::get_table_size() const
 {
-    if(native_impl_ && native_impl_->get_table_size()){
-        return native_impl_->get_table_size();
-    }
-    if(smbios_entry32_ && checksum_validated_){
-        return smbios_entry32_->structure_table_length;
-    }
-    if(smbios_entry64_ && checksum_validated_){
-        return smbios_entry64_->max_structure_size;
-    }
-    return 0;
+    return table_size_;
 }
 
-std::vector<DMIHeader>& SMBios::get_headers_list()
+std::vector<DMIHeader>& SMBios::get_headers_list() const
 {
+    ensure_index();
     return headers_list_;
 }
 
-void SMBios::read_smbios_table()
+void SMBios::ensure_index() const
 {
-    count_smbios_structures();
+    if (index_once_) {
+        std::call_once(*index_once_, [this]() { read_smbios_table(); });
+    }
+}
+
+void SMBios::read_smbios_table() const
+{
+    if (!headers_list_.empty()) {
+        // precomputed index has been loaded from the snapshot
+        return;
+    }
 
     const uint8_t* table_base = get_table_base();
     const uint8_t* table_end = table_base + get_table_size();
-    
-    size_t number_of_structures = get_structures_count();
+
+    // entry point count is exact where it is provided (2.x), otherwise the hint is capped,
+    // so that the index of a large table grows as needed instead of being reserved up front
+    headers_list_.reserve(0 != entry_point_info_.structures_number
+                          ? entry_point_info_.structures_number
+                          : std::min(get_table_size() / 4, max_reserved_headers));
+
+    size_t structures_count = 0;
     const uint8_t* current_structure_begin = table_base;
 
-    for (size_t i = 0; i < number_of_structures && current_structure_begin <= table_end; ++i) {
+    // every structure should contain at least the header
+    while (current_structure_begin + 4 <= table_end) {
 
         DMIHeader header = *reinterpret_cast<const DMIHeader*>(current_structure_begin);
         header.data = current_structure_begin;
 
-        if (header.length < 4) {
+        if (header.length < 4 || current_structure_begin + header.length > table_end) {
             // Invalid entry length. DMI table is broken
             break;
         }
 
+        ++structures_count;
         if (header.type == SMBiosHandler::EndOfTable) {
             // end of table marker. Exit
             break;
         }
 
         headers_list_.push_back(header);
+        ++type_counts_[header.type];
 
         // look to the current structure end '\0\0'
         current_structure_begin = current_structure_begin + header.length;
-        while (current_structure_begin < table_end &&
+        while (current_structure_begin + 1 < table_end &&
                (current_structure_begin[0] != 0 || current_structure_begin[1] != 0)) {
 
             current_structure_begin++;
         }
         current_structure_begin += 2;
     }
+    structures_count_ = structures_count;
 }
 
+void SMBios::count_structure_types() const
+{
+    type_counts_.fill(0);
+    for (const DMIHeader& header : headers_list_) {
+        ++type_counts_[header.type];
+    }
+}
 
-void SMBios::count_smbios_structures()
+std::vector<DMIHeader> SMBios::find_structures(const StructurePredicate& predicate, size_t max_matches) const
 {
-    // start and end of the BIOS table
-    const uint8_t* start_table = get_table_base();
-    const uint8_t* end_table = start_table + get_table_size();
+    std::vector<DMIHeader> found;
+    if (0 == max_matches) {
+        return found;
+    }
 
-    //points to the actual address in the buff that's been checked
-    const uint8_t* offset = start_table;
+    const uint8_t* table_end = table_base_ + table_size_;
+    const uint8_t* current_structure_begin = table_base_;
 
-    //header of the struct been read to get the length to increase the offset
-    const DMIHeader* header = nullptr;
+    // every structure should contain at least the header
+    while (current_structure_begin + 4 <= table_end) {
 
-    size_t structures_count = 0;
+        DMIHeader header = *reinterpret_cast<const DMIHeader*>(current_structure_begin);
+        header.data = current_structure_begin;
 
-    //searches structures on the whole SMBIOS Table
-    while (offset < end_table) {
+        if (header.length < 4 || current_structure_begin + header.length > table_end
+                || header.type == SMBiosHandler::EndOfTable) {
+            // DMI table is broken or end of table marker
+            break;
+        }
 
-        //get the header to read the length and to increase the offset
-        header = reinterpret_cast<const DMIHeader*>(offset);
-        offset += header->length;
+        if (predicate(header)) {
+            found.push_back(header);
+            if (found.size() == max_matches) {
+                break;
+            }
+        }
 
-        structures_count++;
+        // look to the current structure end '\0\0'
+        current_structure_begin = current_structure_begin + header.length;
+        while (current_structure_begin + 1 < table_end &&
+               (current_structure_begin[0] != 0 || current_structure_begin[1] != 0)) {
 
-        // increases the offset to point to the next header that's
-        // after the strings at the end of the structure.
-        while ((*reinterpret_cast<const uint16_t*>(offset) != 0) && (offset < end_table)) {
-            offset++;
+            current_structure_begin++;
         }
-
-        // Points to the next structure that after two null bytes
-        // at the end of the strings section
-        offset += 2;
+        current_structure_begin += 2;
     }
+    return found;
+}
 
-    structures_count_ = structures_count;
+std::vector<DMIHeader> SMBios::find_structures(const std::set<uint8_t>& types, size_t max_matches) const
+{
+    return find_structures([&types](const DMIHeader& header) { return 0 != types.count(header.type); }, max_matches);
 }
 
-void SMBios::scan_physical_memory(const std::vector<uint8_t> &devmem_array)
+bool SMBios::read_entry_point(const uint8_t* entry_point, size_t entry_point_size)
 {
-    constexpr size_t smbios32_header_size = sizeof(SMBIOSEntryPoint32);
-    constexpr size_t smbios64_header_size = sizeof(SMBIOSEntryPoint64);
+    SMBiosEntryPointInfo entry_point_info;
+    if (!parse_smbios_entry_point(entry_point, entry_point_size, entry_point_info)) {
+        return false;
+    }
 
-    for (auto it = devmem_array.begin(); std::distance(it, devmem_array.end()) > 16; it += 16) {
+    // entry point is tiny, keep own copy so that caller could release it
+    // (parser guarantees that the whole structure fits even if reported length is shorter)
+    size_t structure_size = sizeof(SMBIOSEntryPoint64);
+    if (SMBiosAnchorType::SMBios32 == entry_point_info.anchor_type) {
+        structure_size = sizeof(SMBIOSEntryPoint32);
+    }
+    if (SMBiosAnchorType::SMBiosLegacy == entry_point_info.anchor_type) {
+        structure_size = sizeof(SMBIOSEntryPointLegacy);
+    }
+    size_t saved_size = std::max(entry_point_info.entry_point_length, structure_size);
+    entry_point_buffer_.assign(entry_point, entry_point + saved_size);
+    smbios_entry32_ = nullptr;
+    smbios_entry64_ = nullptr;
+    smbios_entry_legacy_ = nullptr;
+    if (SMBiosAnchorType::SMBios32 == entry_point_info.anchor_type) {
+        smbios_entry32_ = reinterpret_cast<const SMBIOSEntryPoint32*>(&entry_point_buffer_[0]);
+    }
+    if (SMBiosAnchorType::SMBios64 == entry_point_info.anchor_type) {
+        smbios_entry64_ = reinterpret_cast<const SMBIOSEntryPoint64*>(&entry_point_buffer_[0]);
+    }
+    if (SMBiosAnchorType::SMBiosLegacy == entry_point_info.anchor_type) {
+        smbios_entry_legacy_ = reinterpret_cast<const SMBIOSEntryPointLegacy*>(&entry_point_buffer_[0]);
+    }
+    checksum_validated_ = true;
+    entry_point_info_ = entry_point_info;
 
-        if(detect_smbios_anchor(it) == SMBiosAnchorType::SMBios32){
+    major_version_ = entry_point_info.major_version;
+    minor_version_ = entry_point_info.minor_version;
+    return true;
+}
 
-            entry_point_buffer_.assign(it, it + smbios32_header_size);
-            smbios_entry32_ = reinterpret_cast<const SMBIOSEntryPoint32*>(&entry_point_buffer_[0]);
-            checksum_validated_ = checksum32();
-        }
+void SMBios::read_native_entry_point()
+{
+    // entry point has been validated by the native implementation already
+    const std::vector<uint8_t>& entry_point = native_impl_->get_entry_point();
+    if (!entry_point.empty()) {
+        read_entry_point(entry_point.data(), entry_point.size());
+    }
+}
 
-        if(detect_smbios_anchor(it) == SMBiosAnchorType::SMBios64){
+void SMBios::read_from_physical_memory(const std::string& root_path)
+{
+    {
+        // read service memory, the scan mapping is released right after the scan
+        smbios::PhysicalMemory physical_memory_device(devmem_base_, devmem_length_, PhysicalMemoryAccess::Auto, root_path);
+        PhysicalMemoryView devmem_area = physical_memory_device.get_memory_view(0, devmem_length_);
 
-            entry_point_buffer_.assign(it, it + smbios64_header_size);
-            smbios_entry64_ = reinterpret_cast<const SMBIOSEntryPoint64*>(&entry_point_buffer_[0]);
-            checksum_validated_ = checksum64();
+        // scan for headers, SMBIOS3 entry point is preferred
+        SMBiosScanResult scan_result = scan_smbios_entry_point(devmem_area.data(), devmem_area.size());
+        if (scan_result.entry_point) {
+            read_entry_point(scan_result.entry_point, devmem_area.end() - scan_result.entry_point);
         }
     }
+
+    if (entry_point_buffer_.empty() || 0 == entry_point_info_.table_length) {
+        throw std::runtime_error("SMBIOS entry point has not been found in physical memory");
+    }
+
+    table_memory_ = std::make_unique<PhysicalMemory>(entry_point_info_.table_address, entry_point_info_.table_length,
+                                                     PhysicalMemoryAccess::Auto, root_path);
+    PhysicalMemoryView table_view = table_memory_->get_memory_view(0, entry_point_info_.table_length);
+    table_base_ = table_view.data();
+    table_size_ = table_view.size();
 }
 
-void SMBios::extract_dmi_version()
+std::vector<uint8_t> SMBios::make_dump_bin() const
 {
-    if(smbios_entry32_ && checksum_validated_) {
-        major_version_ = static_cast<size_t>(smbios_entry32_->major_version);
-        minor_version_ = static_cast<size_t>(smbios_entry32_->minor_version);
+    std::vector<uint8_t> dump(dump_bin_table_offset, 0);
+
+    // per-type entries are not the table described by the firmware entry point
+    if (!entry_point_buffer_.empty() && SMBiosSource::SysFSEntries != acquisition_report_.source) {
+        std::copy_n(entry_point_buffer_.begin(), std::min(entry_point_buffer_.size(), dump.size()), dump.begin());
     }
-    if(smbios_entry64_ && checksum_validated_) {
-        major_version_ = static_cast<size_t>(smbios_entry64_->major_version);
-        minor_version_ = static_cast<size_t>(smbios_entry64_->minor_version);
+    else {
+        const SMBiosVersion version = get_smbios_version();
+        const TableLayout layout = get_table_layout(table_base_, table_size_);
+
+        if (version.major_version >= 3 || 0 == version.major_version) {
+            // unknown version is written as 3.0
+            SMBIOSEntryPoint64* smbios_entry64 = reinterpret_cast<SMBIOSEntryPoint64*>(&dump[0]);
+            std::copy_n("_SM3_", 5, smbios_entry64->entry_point_anchor);
+            smbios_entry64->entry_point_length = sizeof(SMBIOSEntryPoint64);
+            smbios_entry64->major_version = static_cast<uint8_t>(version.major_version ? version.major_version : 3);
+            smbios_entry64->minor_version = static_cast<uint8_t>(version.major_version ? version.minor_version : 0);
+            smbios_entry64->entry_point_revision = 1;
+            smbios_entry64->max_structure_size = static_cast<uint32_t>(table_size_);
+        }
+        else if (table_size_ > numeric_limits<uint16_t>::max()) {
+            throw std::runtime_error("SMBIOS 2.x table longer than 64K could not be described by the entry point");
+        }
+        else {
+            SMBIOSEntryPoint32* smbios_entry32 = reinterpret_cast<SMBIOSEntryPoint32*>(&dump[0]);
+            std::copy_n("_SM_", 4, smbios_entry32->entry_point_anchor);
+            smbios_entry32->entry_point_length = sizeof(SMBIOSEntryPoint32);
+            smbios_entry32->major_version = static_cast<uint8_t>(version.major_version);
+            smbios_entry32->minor_version = static_cast<uint8_t>(version.minor_version);
+            smbios_entry32->max_structure_size = static_cast<uint16_t>(layout.max_structure_size);
+            std::copy_n("_DMI_", 5, smbios_entry32->intermediate_anchor);
+            smbios_entry32->structure_table_length = static_cast<uint16_t>(table_size_);
+            smbios_entry32->smbios_structures_number = static_cast<uint16_t>(layout.structures_number);
+            smbios_entry32->smbios_bcd_revision = static_cast<uint8_t>((version.major_version << 4) | (version.minor_version & 0x0F));
+        }
+    }
+
+    if (!relocate_smbios_entry_point(&dump[0], dump.size(), dump_bin_table_offset)) {
+        throw std::runtime_error("SMBIOS entry point could not be relocated");
     }
+    dump.insert(dump.end(), table_base_, table_base_ + table_size_);
+    return dump;
 }
 
-bool SMBios::checksum32() const
+std::vector<uint8_t> SMBios::make_snapshot() const
 {
-    uint8_t smbios_intermediate_anchor[] = {'_','D','M','I','_'};
-    bool is_anchor_correct = std::equal(
-                std::begin(smbios_intermediate_anchor),
-                std::end(smbios_intermediate_anchor),
-                smbios_entry32_->intermediate_anchor);
+    if (table_size_ > numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("SMBIOS table is too large for the snapshot index");
+    }
+    ensure_index();
 
-    bool crc_correct = (0u == smbios_crc(0, smbios_entry32_->entry_point_length)
-                        && (0u == smbios_crc(0x10, 0x0F)));
+    auto align = [](size_t offset) { return (offset + 7) & ~static_cast<size_t>(7); };
 
-    return is_anchor_correct && crc_correct;
-}
+    const size_t entry_point_offset = sizeof(SMBiosSnapshotHeader);
+    const size_t index_offset = align(entry_point_offset + entry_point_buffer_.size());
+    const size_t table_offset = align(index_offset + headers_list_.size() * sizeof(SMBiosSnapshotIndexEntry));
+    std::vector<uint8_t> snapshot(table_offset + table_size_, 0);
 
-bool SMBios::checksum64() const
-{
-    return (0u == smbios_crc(0, smbios_entry64_->entry_point_length));
-}
+    const SMBiosVersion version = get_smbios_version();
+    SMBiosSnapshotHeader* snapshot_header = reinterpret_cast<SMBiosSnapshotHeader*>(&snapshot[0]);
+    std::copy(std::begin(smbios_snapshot_magic), std::end(smbios_snapshot_magic), snapshot_header->magic);
+    snapshot_header->format_version = smbios_snapshot_format_version;
+    snapshot_header->header_length = sizeof(SMBiosSnapshotHeader);
+    snapshot_header->major_version = version.major_version;
+    snapshot_header->minor_version = version.minor_version;
+    // object loaded from the snapshot keeps the original source
+    const SMBiosSource source = SMBiosSource::None != acquisition_report_.snapshot_source
+            ? acquisition_report_.snapshot_source : acquisition_report_.source;
+    snapshot_header->source = static_cast<uint8_t>(source);
+    snapshot_header->entry_point_offset = static_cast<uint32_t>(entry_point_offset);
+    snapshot_header->entry_point_length = static_cast<uint32_t>(entry_point_buffer_.size());
+    snapshot_header->index_offset = static_cast<uint32_t>(index_offset);
+    snapshot_header->index_count = static_cast<uint32_t>(headers_list_.size());
+    snapshot_header->structures_count = static_cast<uint32_t>(structures_count_);
+    snapshot_header->table_offset = table_offset;
+    snapshot_header->table_length = table_size_;
 
-uint8_t SMBios::smbios_crc(uint8_t start_offset, uint8_t length) const
-{
-    uint8_t sum{};
-    for (size_t a = start_offset; a < length; a++)
-        sum += entry_point_buffer_[a];
-    return sum;
+    std::copy(entry_point_buffer_.begin(), entry_point_buffer_.end(), snapshot.begin() + entry_point_offset);
+
+    const uint8_t* table_end = table_base_ + table_size_;
+    SMBiosSnapshotIndexEntry* index = reinterpret_cast<SMBiosSnapshotIndexEntry*>(&snapshot[index_offset]);
+    for (const DMIHeader& header : headers_list_) {
+        // structure ends with '\0\0' after the formatted area
+        const uint8_t* structure_end = header.data + header.length;
+        while (structure_end + 1 < table_end && (structure_end[0] != 0 || structure_end[1] != 0)) {
+            structure_end++;
+        }
+        structure_end = std::min(structure_end + 2, table_end);
+
+        index->type = header.type;
+        index->length = header.length;
+        index->handle = header.handle;
+        index->offset = static_cast<uint32_t>(header.data - table_base_);
+        index->size = static_cast<uint32_t>(structure_end - header.data);
+        ++index;
+    }
+
+    std::copy(table_base_, table_end, snapshot.begin() + table_offset);
+    return snapshot;
 }
 
 std::string SMBios::render_to_description() const
@@ -315,12 +1002,23 @@ std::string SMBios::render_to_description() const
         decsription << "SMBIOS checksum: " << static_cast<size_t>(smbios_entry64_->entry_point_checksum) << '\n';
         decsription << "SMBIOS length: " << static_cast<size_t>(smbios_entry64_->entry_point_length) << '\n';
         decsription << "SMBIOS major version: " << static_cast<size_t>(smbios_entry64_->major_version) << '\n';
-        decsription << "SMBIOS minor version: " << static_cast<size_t>(smbios_entry32_->minor_version) << '\n';
+        decsription << "SMBIOS minor version: " << static_cast<size_t>(smbios_entry64_->minor_version) << '\n';
         decsription << "SMBIOS doc version: " << static_cast<size_t>(smbios_entry64_->smbios_docrev) << '\n';
         decsription << "Reserved byte: " <<  static_cast<size_t>(smbios_entry64_->reserved) << '\n';
         decsription << "Maximum structure size: " << smbios_entry64_->max_structure_size << '\n';
         decsription << "Table address: " << std::hex << smbios_entry64_->structure_table_address << std::dec << '\n';
         return std::move(decsription.str());
     }
+
+    if(smbios_entry_legacy_ && checksum_validated_) {
+
+        std::stringstream decsription;
+        decsription << "Legacy DMI checksum: " << static_cast<size_t>(smbios_entry_legacy_->entry_point_checksum) << '\n';
+        decsription << "Structure table length: " << smbios_entry_legacy_->structure_table_length << '\n';
+        decsription << "Table address: " << std::hex << smbios_entry_legacy_->structure_table_address << std::dec << '\n';
+        decsription << "SMBIOS structures count: " << smbios_entry_legacy_->smbios_structures_number << '\n';
+        decsription << "SMBIOS BCD revision: " << static_cast<size_t>(smbios_entry_legacy_->smbios_bcd_revision) << '\n';
+        return std::move(decsription.str());
+    }
     return std::string{};
 }
@@ -0,0 +1,38 @@
+#include <smbios/smbios_acquisition.h>
+
+using namespace smbios;
+
+const char* smbios::get_source_name(SMBiosSource source)
+{
+    switch (source) {
+    case SMBiosSource::FirmwareTable:
+        return "firmware table";
+    case SMBiosSource::SysFS:
+        return "sysfs";
+    case SMBiosSource::SysFSEntries:
+        return "sysfs entries";
+    case SMBiosSource::EFI:
+        return "EFI";
+    case SMBiosSource::PhysicalMemoryScan:
+        return "physical memory scan";
+    case SMBiosSource::DumpFile:
+        return "dump file";
+    case SMBiosSource::Memory:
+        return "memory";
+    case SMBiosSource::Cache:
+        return "boot cache";
+    case SMBiosSource::SharedMemory:
+        return "shared memory";
+    default:
+        return "none";
+    }
+}
+
+std::vector<AcquisitionStep> AcquisitionPolicy::default_steps()
+{
+#if defined(_WIN32) || defined(_WIN64)
+    return {{SMBiosSource::FirmwareTable}, {SMBiosSource::PhysicalMemoryScan}};
+#else
+    return {{SMBiosSource::SysFS}, {SMBiosSource::EFI}, {SMBiosSource::PhysicalMemoryScan}};
+#endif
+}
@@ -0,0 +1,231 @@
+#include <smbios/smbios_anchor_scanner.h>
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SMBIOS_SCANNER_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(SMBIOS_SCANNER_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define SMBIOS_SCANNER_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace smbios;
+
+namespace {
+
+/// Entry point is always paragraph-aligned
+constexpr size_t paragraph_size = 16;
+
+/// Wide block is scanned at once, candidate mask has bit per paragraph
+constexpr size_t block_paragraphs = 16;
+constexpr size_t block_size = paragraph_size * block_paragraphs;
+
+/// First 4 bytes of '_SM_', '_SM3_' and '_DMI_' anchors
+const uint32_t anchor_sm = 0x5F4D535F;   // "_SM_"
+const uint32_t anchor_sm3 = 0x334D535F;  // "_SM3"
+const uint32_t anchor_dmi = 0x494D445F;  // "_DMI"
+
+/// Block scanner returns bit mask of paragraphs starting with any anchor prefix
+typedef uint32_t (*BlockScanner)(const uint8_t* block);
+
+inline bool is_anchor_prefix(const uint8_t* paragraph)
+{
+    uint32_t head{};
+    std::memcpy(&head, paragraph, sizeof(head));
+    return (head == anchor_sm) || (head == anchor_sm3) || (head == anchor_dmi);
+}
+
+uint32_t scan_block_scalar(const uint8_t* block)
+{
+    uint32_t mask{};
+    for (size_t i = 0; i < block_paragraphs; ++i) {
+        if (is_anchor_prefix(block + i * paragraph_size)) {
+            mask |= (1u << i);
+        }
+    }
+    return mask;
+}
+
+#if defined(SMBIOS_SCANNER_SSE2)
+
+/// Gather the first dword of 4 consecutive paragraphs and compare with all 3 anchors
+inline uint32_t scan_4_paragraphs_sse2(const uint8_t* paragraphs,
+                                       __m128i sm, __m128i sm3, __m128i dmi)
+{
+    __m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(paragraphs));
+    __m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(paragraphs + 16));
+    __m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(paragraphs + 32));
+    __m128i p3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(paragraphs + 48));
+
+    // p0.d0 p1.d0 p2.d0 p3.d0
+    __m128i heads = _mm_unpacklo_epi64(_mm_unpacklo_epi32(p0, p1), _mm_unpacklo_epi32(p2, p3));
+
+    __m128i hits = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(heads, sm), _mm_cmpeq_epi32(heads, sm3)),
+                                _mm_cmpeq_epi32(heads, dmi));
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(hits)));
+}
+
+uint32_t scan_block_sse2(const uint8_t* block)
+{
+    const __m128i sm = _mm_set1_epi32(static_cast<int>(anchor_sm));
+    const __m128i sm3 = _mm_set1_epi32(static_cast<int>(anchor_sm3));
+    const __m128i dmi = _mm_set1_epi32(static_cast<int>(anchor_dmi));
+
+    return scan_4_paragraphs_sse2(block, sm, sm3, dmi)
+            | (scan_4_paragraphs_sse2(block + 64, sm, sm3, dmi) << 4)
+            | (scan_4_paragraphs_sse2(block + 128, sm, sm3, dmi) << 8)
+            | (scan_4_paragraphs_sse2(block + 192, sm, sm3, dmi) << 12);
+}
+
+#endif // SMBIOS_SCANNER_SSE2
+
+#if defined(SMBIOS_SCANNER_AVX2)
+
+/// Gather the first dword of 8 consecutive paragraphs and compare with all 3 anchors
+/// Lanes are ordered as paragraphs 0,2,4,6,1,3,5,7 because unpack works inside 128-bit lanes
+__attribute__((target("avx2")))
+inline uint32_t scan_8_paragraphs_avx2(const uint8_t* paragraphs,
+                                       __m256i sm, __m256i sm3, __m256i dmi)
+{
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(paragraphs));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(paragraphs + 32));
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(paragraphs + 64));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(paragraphs + 96));
+
+    __m256i heads = _mm256_unpacklo_epi64(_mm256_unpacklo_epi32(a, b), _mm256_unpacklo_epi32(c, d));
+
+    __m256i hits = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi32(heads, sm), _mm256_cmpeq_epi32(heads, sm3)),
+                                   _mm256_cmpeq_epi32(heads, dmi));
+    uint32_t lanes = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hits)));
+    if (0 == lanes) {
+        return 0;
+    }
+
+    // restore paragraph order, candidates are rare
+    uint32_t mask{};
+    for (uint32_t lane = 0; lane < 8; ++lane) {
+        if (lanes & (1u << lane)) {
+            uint32_t paragraph = (lane < 4) ? (lane * 2) : ((lane - 4) * 2 + 1);
+            mask |= (1u << paragraph);
+        }
+    }
+    return mask;
+}
+
+__attribute__((target("avx2")))
+uint32_t scan_block_avx2(const uint8_t* block)
+{
+    const __m256i sm = _mm256_set1_epi32(static_cast<int>(anchor_sm));
+    const __m256i sm3 = _mm256_set1_epi32(static_cast<int>(anchor_sm3));
+    const __m256i dmi = _mm256_set1_epi32(static_cast<int>(anchor_dmi));
+
+    return scan_8_paragraphs_avx2(block, sm, sm3, dmi)
+            | (scan_8_paragraphs_avx2(block + 128, sm, sm3, dmi) << 8);
+}
+
+#endif // SMBIOS_SCANNER_AVX2
+
+BlockScanner select_block_scanner(AnchorScanMethod method)
+{
+    switch (method) {
+#if defined(SMBIOS_SCANNER_AVX2)
+    case AnchorScanMethod::AVX2:
+        return scan_block_avx2;
+#endif
+#if defined(SMBIOS_SCANNER_SSE2)
+    case AnchorScanMethod::SSE2:
+        return scan_block_sse2;
+#endif
+    default:
+        return scan_block_scalar;
+    }
+}
+
+/// SMBIOS3 entry point is preferred over 32-bit one, which is preferred over legacy DMI
+/// (every 32-bit entry point contains valid legacy one at 0x10 offset)
+int entry_point_priority(SMBiosAnchorType anchor_type)
+{
+    switch (anchor_type) {
+    case SMBiosAnchorType::SMBios64:
+        return 3;
+    case SMBiosAnchorType::SMBios32:
+        return 2;
+    case SMBiosAnchorType::SMBiosLegacy:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+/// Validate candidate, remember the first valid entry point of the highest priority
+/// @return true if valid SMBIOS3 entry point has been found and scan should stop
+bool check_candidate(const uint8_t* candidate, size_t remaining, SMBiosScanResult& result)
+{
+    SMBiosEntryPointInfo info;
+    if (!parse_smbios_entry_point(candidate, remaining, info)) {
+        return false;
+    }
+
+    if (entry_point_priority(info.anchor_type) > entry_point_priority(result.info.anchor_type)) {
+        result.entry_point = candidate;
+        result.info = info;
+    }
+    return SMBiosAnchorType::SMBios64 == info.anchor_type;
+}
+
+} // namespace
+
+AnchorScanMethod smbios::resolve_anchor_scan_method(AnchorScanMethod method)
+{
+#if defined(SMBIOS_SCANNER_AVX2)
+    static const bool avx2_supported = __builtin_cpu_supports("avx2");
+#else
+    static const bool avx2_supported = false;
+#endif
+#if defined(SMBIOS_SCANNER_SSE2)
+    const bool sse2_supported = true;
+#else
+    const bool sse2_supported = false;
+#endif
+
+    if ((AnchorScanMethod::Auto == method || AnchorScanMethod::AVX2 == method) && avx2_supported) {
+        return AnchorScanMethod::AVX2;
+    }
+    if (AnchorScanMethod::Scalar != method && sse2_supported) {
+        return AnchorScanMethod::SSE2;
+    }
+    return AnchorScanMethod::Scalar;
+}
+
+SMBiosScanResult smbios::scan_smbios_entry_point(const uint8_t* area, size_t length, AnchorScanMethod method)
+{
+    SMBiosScanResult result;
+    if (nullptr == area) {
+        return result;
+    }
+
+    BlockScanner scan_block = select_block_scanner(resolve_anchor_scan_method(method));
+
+    size_t offset = 0;
+    for (; offset + block_size <= length; offset += block_size) {
+
+        uint32_t candidates = scan_block(area + offset);
+        for (size_t i = 0; candidates; ++i, candidates >>= 1) {
+            if ((candidates & 1u) && check_candidate(area + offset + i * paragraph_size,
+                                                     length - offset - i * paragraph_size, result)) {
+                return result;
+            }
+        }
+    }
+
+    // tail shorter than a block
+    for (; offset + sizeof(uint32_t) <= length; offset += paragraph_size) {
+        if (is_anchor_prefix(area + offset) && check_candidate(area + offset, length - offset, result)) {
+            return result;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,147 @@
+#include <smbios/smbios_cache.h>
+#include <smbios/smbios.h>
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+#include <smbios/posix_file.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <exception>
+
+using namespace smbios;
+
+namespace {
+
+/// Random UUID generated by the kernel on every boot
+const std::string boot_id_path("/proc/sys/kernel/random/boot_id");
+
+/// Cache file is named <prefix><root hash>-<boot id>-<entry point checksum><suffix>
+const std::string cache_file_prefix("smbios-");
+const std::string cache_file_suffix(".cache");
+
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+
+/// Boot id without new line, only characters which are safe in the file name
+bool read_boot_id(const std::string& root_path, std::string& boot_id)
+{
+    std::vector<uint8_t> contents;
+    if (!read_file_contents(make_rooted_path(root_path, boot_id_path), contents)) {
+        return false;
+    }
+    boot_id.clear();
+    for (uint8_t symbol : contents) {
+        if (std::isxdigit(symbol) || '-' == symbol) {
+            boot_id.push_back(static_cast<char>(symbol));
+        }
+    }
+    return !boot_id.empty();
+}
+
+/// Caches of different filesystem roots could share the directory, FNV-1a is stable between processes
+std::string make_root_hash(const std::string& root_path)
+{
+    const std::string root = root_path.empty() ? std::string("/") : root_path;
+    uint32_t hash = 2166136261u;
+    for (char symbol : root) {
+        hash = (hash ^ static_cast<uint8_t>(symbol)) * 16777619u;
+    }
+    char root_hash[9] = {};
+    std::snprintf(root_hash, sizeof(root_hash), "%08x", static_cast<unsigned>(hash));
+    return root_hash;
+}
+
+/// Cache of the same root, its prefix is "<prefix><root hash>-"
+bool is_cache_file_name(const std::string& name, const std::string& root_prefix)
+{
+    return name.size() > root_prefix.size() + cache_file_suffix.size()
+            && 0 == name.compare(0, root_prefix.size(), root_prefix)
+            && 0 == name.compare(name.size() - cache_file_suffix.size(), cache_file_suffix.size(), cache_file_suffix);
+}
+
+#endif
+
+} // namespace
+
+std::string smbios::get_boot_cache_path(const AcquisitionPolicy& policy)
+{
+    SMBiosEntryPointInfo entry_point_info;
+    return get_boot_cache_path(policy, entry_point_info);
+}
+
+std::string smbios::get_boot_cache_path(const AcquisitionPolicy& policy, SMBiosEntryPointInfo& entry_point_info)
+{
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+    if (policy.cache_directory.empty()) {
+        return std::string();
+    }
+
+    std::string boot_id;
+    if (!read_boot_id(policy.root_path, boot_id)) {
+        return std::string();
+    }
+
+    // the key is made before acquisition and out of its budget, so only the sources which read
+    // the entry point alone are probed, never the memory scan or the dump files
+    AcquisitionPolicy key_policy = policy;
+    key_policy.steps.erase(std::remove_if(key_policy.steps.begin(), key_policy.steps.end(), [](const AcquisitionStep& step) {
+        return SMBiosSource::SysFS != step.source && SMBiosSource::SysFSEntries != step.source
+                && SMBiosSource::EFI != step.source;
+    }), key_policy.steps.end());
+    if (key_policy.steps.empty()) {
+        return std::string();
+    }
+
+    SMBiosProbe probe;
+    try {
+        probe = SMBios::probe(key_policy);
+    }
+    catch (const std::exception&) {
+        // no entry point, table could not be told from the cached one
+        return std::string();
+    }
+
+    entry_point_info = probe.entry_point;
+    char checksum[3] = {};
+    std::snprintf(checksum, sizeof(checksum), "%02x", static_cast<unsigned>(probe.entry_point.checksum));
+    std::string directory = policy.cache_directory;
+    if ('/' != directory.back()) {
+        directory.push_back('/');
+    }
+    return directory + cache_file_prefix + make_root_hash(policy.root_path) + '-' + boot_id + '-' + checksum
+            + cache_file_suffix;
+#else
+    (void)policy;
+    (void)entry_point_info;
+    return std::string();
+#endif
+}
+
+bool smbios::store_boot_cache(const std::string& cache_path, const std::vector<uint8_t>& snapshot)
+{
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+    if (cache_path.empty() || !write_file_atomically(cache_path, snapshot)) {
+        return false;
+    }
+
+    // caches of previous boots are never used again, caches of other roots are left to their writers
+    const size_t name_offset = cache_path.rfind('/') + 1;
+    const std::string directory = cache_path.substr(0, name_offset);
+    const std::string cache_name = cache_path.substr(name_offset);
+    const std::string root_prefix = cache_name.substr(0, cache_name.find('-', cache_file_prefix.size()) + 1);
+    std::vector<std::string> names;
+    if (list_directory(directory, names)) {
+        for (const std::string& name : names) {
+            if (name != cache_name && is_cache_file_name(name, root_prefix)) {
+                ::unlink((directory + name).c_str());
+            }
+        }
+    }
+    return true;
+#else
+    (void)cache_path;
+    (void)snapshot;
+    return false;
+#endif
+}
@@ -8,6 +8,7 @@ using namespace smbios;
 SMBiosEntryFactory::SMBiosEntryFactory()
 {
     entries_factory_[SMBios::BIOSInformation] = boost::bind(boost::factory<BiosInformationEntry*>(), _1, _2);
+    entries_factory_[SMBios::SystemInformation] = boost::bind(boost::factory<SystemInformationEntry*>(), _1, _2);
     entries_factory_[SMBios::PortConnection] = boost::bind(boost::factory<PortConnectionEntry*>(), _1, _2);
     entries_factory_[SMBios::MemoryDevice] = boost::bind(boost::factory<MemoryDeviceEntry*>(), _1, _2);
 }
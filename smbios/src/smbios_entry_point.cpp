@@ -0,0 +1,194 @@
+#include <smbios/smbios_entry_point.h>
+#include <smbios/smbios.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+using namespace smbios;
+
+static_assert(sizeof(SMBIOSEntryPoint32) == 0x1F, "SMBIOS 32-bit entry point should be 0x1F bytes");
+static_assert(sizeof(SMBIOSEntryPoint64) == 0x18, "SMBIOS 64-bit entry point should be 0x18 bytes");
+static_assert(sizeof(SMBIOSEntryPointLegacy) == 0x0F, "Legacy DMI entry point should be 0x0F bytes");
+
+namespace {
+
+/// Sum of bytes from start offset to offset+length should be zero
+uint8_t entry_point_crc(const uint8_t* entry_point, size_t start_offset, size_t length)
+{
+    uint8_t sum{};
+    for (size_t a = start_offset; a < start_offset + length; a++)
+        sum += entry_point[a];
+    return sum;
+}
+
+/// Make the sum of bytes from start offset to offset+length zero
+void set_entry_point_crc(uint8_t* entry_point, size_t start_offset, size_t length, size_t checksum_offset)
+{
+    entry_point[checksum_offset] = 0;
+    entry_point[checksum_offset] = static_cast<uint8_t>(0x100 - entry_point_crc(entry_point, start_offset, length));
+}
+
+bool parse_entry_point32(const uint8_t* entry_point, size_t length, SMBiosEntryPointInfo& info)
+{
+    // intermediate anchor and checksum are at 0x10 offset, 0x0F bytes long
+    constexpr size_t intermediate_offset = 0x10;
+    constexpr size_t intermediate_length = 0x0F;
+    constexpr uint8_t smbios_intermediate_anchor[] = {'_','D','M','I','_'};
+
+    if (length < sizeof(SMBIOSEntryPoint32)) {
+        return false;
+    }
+
+    const SMBIOSEntryPoint32* smbios_entry32 = reinterpret_cast<const SMBIOSEntryPoint32*>(entry_point);
+
+    // some 2.1 BIOSes report 0x1E length instead of 0x1F
+    if (smbios_entry32->entry_point_length < 0x1E || smbios_entry32->entry_point_length > length) {
+        return false;
+    }
+
+    bool is_anchor_correct = std::equal(
+                std::begin(smbios_intermediate_anchor),
+                std::end(smbios_intermediate_anchor),
+                smbios_entry32->intermediate_anchor);
+
+    bool crc_correct = (0u == entry_point_crc(entry_point, 0, smbios_entry32->entry_point_length))
+            && (0u == entry_point_crc(entry_point, intermediate_offset, intermediate_length));
+
+    if (!is_anchor_correct || !crc_correct) {
+        return false;
+    }
+
+    info.anchor_type = SMBiosAnchorType::SMBios32;
+    info.entry_point_length = smbios_entry32->entry_point_length;
+    info.major_version = smbios_entry32->major_version;
+    info.minor_version = smbios_entry32->minor_version;
+    info.table_address = smbios_entry32->structure_table_address;
+    info.table_length = smbios_entry32->structure_table_length;
+    info.structures_number = smbios_entry32->smbios_structures_number;
+    info.bcd_revision = smbios_entry32->smbios_bcd_revision;
+    info.checksum = smbios_entry32->entry_point_checksum;
+    return true;
+}
+
+bool parse_entry_point64(const uint8_t* entry_point, size_t length, SMBiosEntryPointInfo& info)
+{
+    if (length < sizeof(SMBIOSEntryPoint64)) {
+        return false;
+    }
+
+    const SMBIOSEntryPoint64* smbios_entry64 = reinterpret_cast<const SMBIOSEntryPoint64*>(entry_point);
+
+    if (smbios_entry64->entry_point_length < sizeof(SMBIOSEntryPoint64)
+            || smbios_entry64->entry_point_length > length) {
+        return false;
+    }
+
+    if (0u != entry_point_crc(entry_point, 0, smbios_entry64->entry_point_length)) {
+        return false;
+    }
+
+    info.anchor_type = SMBiosAnchorType::SMBios64;
+    info.entry_point_length = smbios_entry64->entry_point_length;
+    info.major_version = smbios_entry64->major_version;
+    info.minor_version = smbios_entry64->minor_version;
+    info.table_address = smbios_entry64->structure_table_address;
+    info.table_length = smbios_entry64->max_structure_size;
+    info.structures_number = 0;
+    info.bcd_revision = 0;
+    info.checksum = smbios_entry64->entry_point_checksum;
+    return true;
+}
+
+bool parse_entry_point_legacy(const uint8_t* entry_point, size_t length, SMBiosEntryPointInfo& info)
+{
+    if (length < sizeof(SMBIOSEntryPointLegacy)) {
+        return false;
+    }
+
+    const SMBIOSEntryPointLegacy* smbios_entry_legacy = reinterpret_cast<const SMBIOSEntryPointLegacy*>(entry_point);
+
+    if (0u != entry_point_crc(entry_point, 0, sizeof(SMBIOSEntryPointLegacy))) {
+        return false;
+    }
+
+    info.anchor_type = SMBiosAnchorType::SMBiosLegacy;
+    info.entry_point_length = sizeof(SMBIOSEntryPointLegacy);
+
+    // no version fields, BCD revision 0x21 is 2.1; zero revision is pre-2.1 DMI (treat as 2.0)
+    const uint8_t bcd_revision = smbios_entry_legacy->smbios_bcd_revision;
+    info.major_version = bcd_revision ? (bcd_revision >> 4) : 2;
+    info.minor_version = bcd_revision ? (bcd_revision & 0x0F) : 0;
+    info.table_address = smbios_entry_legacy->structure_table_address;
+    info.table_length = smbios_entry_legacy->structure_table_length;
+    info.structures_number = smbios_entry_legacy->smbios_structures_number;
+    info.bcd_revision = bcd_revision;
+    info.checksum = smbios_entry_legacy->entry_point_checksum;
+    return true;
+}
+
+} // namespace
+
+bool smbios::parse_smbios_entry_point(const uint8_t* entry_point, size_t length, SMBiosEntryPointInfo& info)
+{
+    // the longest anchor should fit
+    if (nullptr == entry_point || length < 5) {
+        return false;
+    }
+
+    switch (detect_smbios_anchor(entry_point)) {
+    case SMBiosAnchorType::SMBios32:
+        return parse_entry_point32(entry_point, length, info);
+    case SMBiosAnchorType::SMBios64:
+        return parse_entry_point64(entry_point, length, info);
+    case SMBiosAnchorType::SMBiosLegacy:
+        return parse_entry_point_legacy(entry_point, length, info);
+    default:
+        return false;
+    }
+}
+
+bool smbios::relocate_smbios_entry_point(uint8_t* entry_point, size_t length, uint64_t table_address)
+{
+    if (nullptr == entry_point || length < 5) {
+        return false;
+    }
+
+    switch (detect_smbios_anchor(entry_point)) {
+    case SMBiosAnchorType::SMBios32: {
+        SMBIOSEntryPoint32* smbios_entry32 = reinterpret_cast<SMBIOSEntryPoint32*>(entry_point);
+        if (length < sizeof(SMBIOSEntryPoint32) || smbios_entry32->entry_point_length > length
+                || table_address > std::numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+        smbios_entry32->structure_table_address = static_cast<uint32_t>(table_address);
+        // intermediate part first, it is covered by the entry point checksum
+        set_entry_point_crc(entry_point, 0x10, 0x0F, offsetof(SMBIOSEntryPoint32, intermediate_checksum));
+        set_entry_point_crc(entry_point, 0, smbios_entry32->entry_point_length,
+                            offsetof(SMBIOSEntryPoint32, entry_point_checksum));
+        return true;
+    }
+    case SMBiosAnchorType::SMBios64: {
+        SMBIOSEntryPoint64* smbios_entry64 = reinterpret_cast<SMBIOSEntryPoint64*>(entry_point);
+        if (length < sizeof(SMBIOSEntryPoint64) || smbios_entry64->entry_point_length > length) {
+            return false;
+        }
+        smbios_entry64->structure_table_address = table_address;
+        set_entry_point_crc(entry_point, 0, smbios_entry64->entry_point_length,
+                            offsetof(SMBIOSEntryPoint64, entry_point_checksum));
+        return true;
+    }
+    case SMBiosAnchorType::SMBiosLegacy: {
+        SMBIOSEntryPointLegacy* smbios_entry_legacy = reinterpret_cast<SMBIOSEntryPointLegacy*>(entry_point);
+        if (length < sizeof(SMBIOSEntryPointLegacy) || table_address > std::numeric_limits<uint32_t>::max()) {
+            return false;
+        }
+        smbios_entry_legacy->structure_table_address = static_cast<uint32_t>(table_address);
+        set_entry_point_crc(entry_point, 0, sizeof(SMBIOSEntryPointLegacy),
+                            offsetof(SMBIOSEntryPointLegacy, entry_point_checksum));
+        return true;
+    }
+    default:
+        return false;
+    }
+}
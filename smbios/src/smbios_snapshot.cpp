@@ -0,0 +1,63 @@
+#include <smbios/smbios_snapshot.h>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace smbios;
+
+static_assert(sizeof(SMBiosSnapshotHeader) == 64, "Snapshot header should be 64 bytes");
+static_assert(sizeof(SMBiosSnapshotIndexEntry) == 12, "Snapshot index entry should be 12 bytes");
+
+namespace {
+
+/// Part [offset, offset + length) should be inside the data
+bool is_inside(uint64_t offset, uint64_t length, size_t data_length)
+{
+    return offset <= data_length && length <= data_length - offset;
+}
+
+} // namespace
+
+bool smbios::parse_smbios_snapshot(const uint8_t* data, size_t length, SMBiosSnapshotInfo& info)
+{
+    if (nullptr == data || length < sizeof(SMBiosSnapshotHeader)) {
+        return false;
+    }
+
+    const SMBiosSnapshotHeader* header = reinterpret_cast<const SMBiosSnapshotHeader*>(data);
+    if (!std::equal(std::begin(smbios_snapshot_magic), std::end(smbios_snapshot_magic), header->magic)
+            || smbios_snapshot_format_version != header->format_version
+            || header->header_length < sizeof(SMBiosSnapshotHeader)) {
+        return false;
+    }
+
+    const uint64_t index_length = static_cast<uint64_t>(header->index_count) * sizeof(SMBiosSnapshotIndexEntry);
+    if (!is_inside(header->entry_point_offset, header->entry_point_length, length)
+            || !is_inside(header->index_offset, index_length, length)
+            || !is_inside(header->table_offset, header->table_length, length)) {
+        return false;
+    }
+
+    const SMBiosSnapshotIndexEntry* index = reinterpret_cast<const SMBiosSnapshotIndexEntry*>(data + header->index_offset);
+    const uint64_t table_length = header->table_length;
+    bool index_correct = std::all_of(index, index + header->index_count, [table_length](const SMBiosSnapshotIndexEntry& entry) {
+        return entry.length >= 4 && entry.length <= entry.size && is_inside(entry.offset, entry.size, table_length);
+    });
+    if (!index_correct) {
+        return false;
+    }
+
+    info.major_version = header->major_version;
+    info.minor_version = header->minor_version;
+    // unknown source of the newer writer is not an error
+    info.source = (header->source <= static_cast<uint8_t>(SMBiosSource::SharedMemory))
+            ? static_cast<SMBiosSource>(header->source) : SMBiosSource::None;
+    info.entry_point = header->entry_point_length ? data + header->entry_point_offset : nullptr;
+    info.entry_point_length = header->entry_point_length;
+    info.index = index;
+    info.index_count = header->index_count;
+    info.structures_count = header->structures_count;
+    info.table = data + header->table_offset;
+    info.table_length = header->table_length;
+    return true;
+}
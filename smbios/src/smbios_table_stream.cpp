@@ -0,0 +1,119 @@
+#include <smbios/smbios_table_stream.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace smbios;
+
+namespace {
+
+/// Every structure should contain at least the header
+constexpr size_t structure_header_size = 4;
+
+/// Size of the structure starting at position, including strings section and '\0\0' terminator
+/// @return zero if structure end is beyond the window
+size_t structure_size_in_window(const uint8_t* window, size_t window_size, size_t position, size_t formatted_length)
+{
+    for (size_t offset = position + formatted_length; offset + 1 < window_size; ++offset) {
+        if (0 == window[offset] && 0 == window[offset + 1]) {
+            return offset + 2 - position;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+SMBiosTableStream::SMBiosTableStream(uint64_t table_address, size_t table_length, size_t window_size,
+                                     const std::string& root_path)
+    : table_address_(table_address), table_length_(table_length),
+      window_size_(std::max(window_size, structure_header_size)), root_path_(root_path)
+{
+}
+
+SMBiosTableStream::~SMBiosTableStream()
+{
+}
+
+size_t SMBiosTableStream::for_each_structure(const StructureVisitor& visitor)
+{
+    max_window_size_ = 0;
+
+    size_t visited = 0;
+    size_t offset = 0;
+    size_t window_offset = 0;
+    PhysicalMemoryView window;
+
+    // table offset of the window beginning is always a structure beginning
+    auto slide_window = [&](size_t length) {
+        length = std::min(length, table_length_ - offset);
+        window = map_window(offset, length);
+        if (window.size() < length) {
+            throw std::runtime_error("SMBIOS table window could not be accessed");
+        }
+        window_offset = offset;
+        max_window_size_ = std::max(max_window_size_, length);
+    };
+
+    while (offset + structure_header_size <= table_length_) {
+
+        if (window.empty() || offset + structure_header_size > window_offset + window.size()) {
+            slide_window(window_size_);
+        }
+
+        size_t position = offset - window_offset;
+        // only 4 header bytes are guaranteed to be inside the window
+        const uint8_t* structure = window.data() + position;
+        DMIHeader header;
+        header.type = structure[0];
+        header.length = structure[1];
+        header.handle = static_cast<uint16_t>(structure[2] | (structure[3] << 8));
+        header.data = structure;
+
+        if (header.length < structure_header_size) {
+            // Invalid entry length. DMI table is broken
+            break;
+        }
+
+        size_t structure_size = structure_size_in_window(window.data(), window.size(), position, header.length);
+        if (0 == structure_size) {
+
+            if (window_offset + window.size() >= table_length_) {
+                // structure is truncated by the table end
+                break;
+            }
+
+            // structure crosses the window end: read it from the beginning,
+            // window grows only if the structure does not fit even from the window beginning
+            slide_window(0 == position ? window.size() * 2 : window_size_);
+            continue;
+        }
+
+        if (header.type == SMBios::EndOfTable) {
+            break;
+        }
+
+        ++visited;
+        if (!visitor(header, structure_size)) {
+            break;
+        }
+        offset += structure_size;
+    }
+    return visited;
+}
+
+size_t SMBiosTableStream::get_max_window_size() const
+{
+    return max_window_size_;
+}
+
+PhysicalMemoryView SMBiosTableStream::map_window(size_t offset, size_t length)
+{
+    // reading keeps memory bounded: mapped windows would be cached and merged by the pool
+    if (!window_memory_) {
+        window_memory_ = std::make_unique<PhysicalMemory>();
+    }
+    window_memory_->map_physical_memory(static_cast<size_t>(table_address_ + offset), length,
+                                        PhysicalMemoryAccess::Read, root_path_);
+    return window_memory_->get_memory_view(0, length);
+}
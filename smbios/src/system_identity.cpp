@@ -0,0 +1,173 @@
+#include <smbios/system_identity.h>
+#include <smbios/smbios.h>
+#include <smbios/bios_information_entry.h>
+#include <smbios/system_information_entry.h>
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+#include <smbios/posix_file.h>
+#endif
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <vector>
+
+using namespace smbios;
+
+namespace {
+
+/// Kernel DMI identity attributes
+const std::string dmi_id_path("/sys/class/dmi/id/");
+
+/// Identity field and its attribute name
+struct IdentityAttribute
+{
+    const char* name;
+    std::string SystemIdentity::* field;
+};
+
+const IdentityAttribute identity_attributes[] = {
+    {"product_uuid", &SystemIdentity::product_uuid},
+    {"product_serial", &SystemIdentity::product_serial},
+    {"product_name", &SystemIdentity::product_name},
+    {"sys_vendor", &SystemIdentity::system_vendor},
+    {"bios_vendor", &SystemIdentity::bios_vendor},
+    {"bios_version", &SystemIdentity::bios_version},
+    {"bios_date", &SystemIdentity::bios_date}
+};
+
+/// Read attribute value without trailing new line
+/// @return false if attribute is missing, unreadable (product_uuid and product_serial are root-only) or empty
+bool read_identity_attribute(const std::string& root_path, const std::string& name, std::string& value)
+{
+#if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
+    std::vector<uint8_t> contents;
+    if (!read_file_contents(make_rooted_path(root_path, dmi_id_path + name), contents)) {
+        return false;
+    }
+    while (!contents.empty() && ('\n' == contents.back() || ' ' == contents.back())) {
+        contents.pop_back();
+    }
+    value.assign(contents.begin(), contents.end());
+    return !value.empty();
+#else
+    (void)root_path;
+    (void)name;
+    (void)value;
+    return false;
+#endif
+}
+
+/// Take DMI string only if it is specified
+void assign_if_missing(std::string& field, uint8_t string_index, const std::string& value)
+{
+    if (field.empty() && 0 != string_index) {
+        field = value;
+    }
+}
+
+/// Fill missing fields from the first System and BIOS Information structures
+void decode_identity_from_table(const std::string& root_path, SystemIdentity& identity)
+{
+    try {
+        // only these two structures are read where per-type entries are available
+        SMBios smbios(std::set<uint8_t>{SMBios::BIOSInformation, SMBios::SystemInformation}, root_path);
+        SMBiosVersion version = smbios.get_smbios_version();
+        if (0 == version.major_version) {
+            // version is not known, layout is limited by the structure length only
+            version = SMBiosVersion{3, 0};
+        }
+
+        // only the first structure of each type is decoded, walk stops as soon as both are found
+        std::set<uint8_t> wanted_types{SMBios::BIOSInformation, SMBios::SystemInformation};
+        auto first_of_type = [&wanted_types](const DMIHeader& header) { return 0 != wanted_types.erase(header.type); };
+
+        bool system_decoded = false;
+        bool bios_decoded = false;
+        for (const DMIHeader& header : smbios.find_structures(first_of_type, 2)) {
+
+            if (SMBios::SystemInformation == header.type) {
+                SystemInformationEntry system_information(header, version);
+                if (identity.product_uuid.empty()) {
+                    identity.product_uuid = system_information.get_uuid_string();
+                }
+                assign_if_missing(identity.product_serial, system_information.get_serial_number_index(),
+                                  system_information.get_serial_number_string());
+                assign_if_missing(identity.product_name, system_information.get_product_name_index(),
+                                  system_information.get_product_name_string());
+                assign_if_missing(identity.system_vendor, system_information.get_manufacturer_index(),
+                                  system_information.get_manufacturer_string());
+                system_decoded = true;
+            }
+
+            if (SMBios::BIOSInformation == header.type) {
+                BiosInformationEntry bios_information(header, version);
+                assign_if_missing(identity.bios_vendor, bios_information.get_vendor_index(),
+                                  bios_information.get_vendor_string());
+                assign_if_missing(identity.bios_version, bios_information.get_version_index(),
+                                  bios_information.get_version_string());
+                assign_if_missing(identity.bios_date, bios_information.get_release_date_index(),
+                                  bios_information.get_release_date_string());
+                bios_decoded = true;
+            }
+        }
+        identity.decoded_from_table = system_decoded || bios_decoded;
+    }
+    catch (const std::exception&) {
+        // no table source is available, identity is what attributes have provided
+    }
+}
+
+/// No field has been read
+bool is_empty_identity(const SystemIdentity& identity)
+{
+    for (const IdentityAttribute& attribute : identity_attributes) {
+        if (!(identity.*attribute.field).empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+SystemIdentity smbios::read_system_identity(const std::string& root_path)
+{
+    SystemIdentity identity;
+    bool all_attributes_read = true;
+    for (const IdentityAttribute& attribute : identity_attributes) {
+        if (!read_identity_attribute(root_path, attribute.name, identity.*attribute.field)) {
+            all_attributes_read = false;
+        }
+    }
+
+    if (!all_attributes_read) {
+        decode_identity_from_table(root_path, identity);
+    }
+    return identity;
+}
+
+const SystemIdentity& smbios::get_system_identity()
+{
+    static std::mutex identity_lock;
+    static std::atomic<const SystemIdentity*> cached_identity{nullptr};
+    static SystemIdentity identity;
+
+    if (const SystemIdentity* cached = cached_identity.load(std::memory_order_acquire)) {
+        return *cached;
+    }
+
+    std::lock_guard<std::mutex> lock(identity_lock);
+    if (const SystemIdentity* cached = cached_identity.load(std::memory_order_relaxed)) {
+        return *cached;
+    }
+
+    // nothing could be read yet (early boot, no permissions): not cached, next call reads again
+    thread_local SystemIdentity uncached_identity;
+    uncached_identity = read_system_identity();
+    if (is_empty_identity(uncached_identity)) {
+        return uncached_identity;
+    }
+    identity = uncached_identity;
+    cached_identity.store(&identity, std::memory_order_release);
+    return identity;
+}
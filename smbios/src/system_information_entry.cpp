@@ -0,0 +1,204 @@
+#include <smbios/system_information_entry.h>
+#include <smbios/smbios.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <cassert>
+
+using namespace smbios;
+
+SystemInformationEntry::SystemInformationEntry(const DMIHeader& header, const SMBiosVersion& version)
+    : AbstractSMBiosEntry(header)
+{
+    if (header.type != SMBios::SystemInformation) {
+        std::stringstream err;
+        err << "Wrong entry type, expected System Information, called Type = " << header.type;
+        throw std::runtime_error(err.str().c_str());
+    }
+
+    init_string_values();
+
+    // check empty entry
+    if (header.length < 0x08)
+        return;
+
+    system_information20_ = reinterpret_cast<const SystemInformationV20*>(header.data);
+
+    // 2.1+
+    if ((header.length >= 0x19) && (version > SMBiosVersion{ 2, 0 })) {
+        system_information21_ = reinterpret_cast<const SystemInformationV21*>(header.data);
+    }
+
+    // 2.4+
+    if ((header.length >= 0x1B) && (version > SMBiosVersion{ 2, 3 })) {
+        system_information24_ = reinterpret_cast<const SystemInformationV24*>(header.data);
+    }
+
+    // 2.6+ (unknown version is the latest one)
+    uuid_little_endian_ = (0 == version.major_version) || (version > SMBiosVersion{ 2, 5 });
+}
+
+std::string SystemInformationEntry::get_type() const
+{
+    return "System Information";
+}
+
+std::string SystemInformationEntry::render_to_description() const
+{
+    std::stringstream decsription;
+    decsription << "Header type: " << get_type() << '\n';
+    decsription << "Manufacturer: " << get_manufacturer_string() << '\n';
+    decsription << "Product Name: " << get_product_name_string() << '\n';
+    decsription << "Version: " << get_version_string() << '\n';
+    decsription << "Serial Number: " << get_serial_number_string() << '\n';
+    decsription << "UUID: " << get_uuid_string() << '\n';
+    decsription << "Wake-up Type: " << get_wakeup_type_string() << '\n';
+    decsription << "SKU Number: " << get_sku_number_string() << '\n';
+    decsription << "Family: " << get_family_string() << '\n';
+
+    return std::move(decsription.str());
+}
+
+uint8_t SystemInformationEntry::get_manufacturer_index() const
+{
+    if (nullptr == system_information20_) {
+        return 0;
+    }
+    return system_information20_->manufacturer;
+}
+
+uint8_t SystemInformationEntry::get_product_name_index() const
+{
+    if (nullptr == system_information20_) {
+        return 0;
+    }
+    return system_information20_->product_name;
+}
+
+uint8_t SystemInformationEntry::get_version_index() const
+{
+    if (nullptr == system_information20_) {
+        return 0;
+    }
+    return system_information20_->version;
+}
+
+uint8_t SystemInformationEntry::get_serial_number_index() const
+{
+    if (nullptr == system_information20_) {
+        return 0;
+    }
+    return system_information20_->serial_number;
+}
+
+const uint8_t* SystemInformationEntry::get_uuid() const
+{
+    if (nullptr == system_information21_) {
+        return nullptr;
+    }
+    return system_information21_->uuid;
+}
+
+uint8_t SystemInformationEntry::get_wakeup_type() const
+{
+    if (nullptr == system_information21_) {
+        return 0;
+    }
+    return system_information21_->wakeup_type;
+}
+
+uint8_t SystemInformationEntry::get_sku_number_index() const
+{
+    if (nullptr == system_information24_) {
+        return 0;
+    }
+    return system_information24_->sku_number;
+}
+
+uint8_t SystemInformationEntry::get_family_index() const
+{
+    if (nullptr == system_information24_) {
+        return 0;
+    }
+    return system_information24_->family;
+}
+
+void SystemInformationEntry::init_string_values()
+{
+    wakeup_type_map_[WakeupReserved] = "Reserved";
+    wakeup_type_map_[WakeupOther] = "Other";
+    wakeup_type_map_[WakeupUnknown] = "Unknown";
+    wakeup_type_map_[APMTimer] = "APM Timer";
+    wakeup_type_map_[ModemRing] = "Modem Ring";
+    wakeup_type_map_[LANRemote] = "LAN Remote";
+    wakeup_type_map_[PowerSwitch] = "Power Switch";
+    wakeup_type_map_[PCIPME] = "PCI PME#";
+    wakeup_type_map_[ACPowerRestored] = "AC Power Restored";
+}
+
+std::string SystemInformationEntry::get_manufacturer_string() const
+{
+    return AbstractSMBiosEntry::dmi_string(get_manufacturer_index());
+}
+
+std::string SystemInformationEntry::get_product_name_string() const
+{
+    return AbstractSMBiosEntry::dmi_string(get_product_name_index());
+}
+
+std::string SystemInformationEntry::get_version_string() const
+{
+    return AbstractSMBiosEntry::dmi_string(get_version_index());
+}
+
+std::string SystemInformationEntry::get_serial_number_string() const
+{
+    return AbstractSMBiosEntry::dmi_string(get_serial_number_index());
+}
+
+std::string SystemInformationEntry::get_uuid_string() const
+{
+    const uint8_t* uuid = get_uuid();
+    if (nullptr == uuid) {
+        return std::string();
+    }
+
+    // all 0xFF - not present, all zeros - not set
+    if (std::all_of(uuid, uuid + 16, [](uint8_t byte) { return 0xFF == byte; })
+            || std::all_of(uuid, uuid + 16, [](uint8_t byte) { return 0x00 == byte; })) {
+        return std::string();
+    }
+
+    const size_t little_endian_order[16] = {3, 2, 1, 0, 5, 4, 7, 6, 8, 9, 10, 11, 12, 13, 14, 15};
+    std::stringstream uuid_stream;
+    uuid_stream << std::hex << std::setfill('0');
+    for (size_t i = 0; i < 16; ++i) {
+        if (4 == i || 6 == i || 8 == i || 10 == i) {
+            uuid_stream << '-';
+        }
+        size_t byte_index = uuid_little_endian_ ? little_endian_order[i] : i;
+        uuid_stream << std::setw(2) << static_cast<unsigned>(uuid[byte_index]);
+    }
+    return std::move(uuid_stream.str());
+}
+
+std::string SystemInformationEntry::get_wakeup_type_string() const
+{
+    assert(!wakeup_type_map_.empty());
+    auto it = wakeup_type_map_.find(get_wakeup_type());
+    if (it == wakeup_type_map_.end()) {
+        return "Out Of Spec";
+    }
+    return it->second;
+}
+
+std::string SystemInformationEntry::get_sku_number_string() const
+{
+    return AbstractSMBiosEntry::dmi_string(get_sku_number_index());
+}
+
+std::string SystemInformationEntry::get_family_string() const
+{
+    return AbstractSMBiosEntry::dmi_string(get_family_index());
+}
@@ -1,6 +1,9 @@
 #if defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
 #include <smbios/unix_bios.h>
 #include <smbios/smbios_anchor.h>
+#include <smbios/posix_file.h>
+#include <smbios/physical_memory.h>
+#include <smbios/smbios.h>
 
 #include <cassert>
 #include <string>
@@ -8,12 +11,64 @@
 #include <algorithm>
 #include <fstream>
 #include <iterator>
+#include <utility>
+#include <limits>
+#include <cstdlib>
+#include <stdexcept>
+#include <unistd.h>
 
 using namespace smbios;
 
+namespace {
+
+/// Kernel exports entry point and the table here since 2.6.38
+const std::string sysfs_entry_point_path("/sys/firmware/dmi/tables/smbios_entry_point");
+const std::string sysfs_table_path("/sys/firmware/dmi/tables/DMI");
+
+/// Every structure is exported as <type>-<instance>/raw since 2.6.39
+const std::string sysfs_entries_path("/sys/firmware/dmi/entries");
+
+/// Parse "<type>-<instance>" sysfs entry name
+bool parse_entry_name(const std::string& entry_name, unsigned long& type, unsigned long& instance)
+{
+    const char* name = entry_name.c_str();
+    char* type_end = nullptr;
+    type = std::strtoul(name, &type_end, 10);
+    if (type_end == name || '-' != *type_end || type > 0xFF) {
+        return false;
+    }
+    char* instance_end = nullptr;
+    instance = std::strtoul(type_end + 1, &instance_end, 10);
+    return (instance_end != type_end + 1) && ('\0' == *instance_end);
+}
+
+/// Parse "SMBIOS3=0x..." or "SMBIOS=0x..." EFI system table line
+bool parse_systab_address(const std::string& systab_entry, const std::string& key, uint64_t& address)
+{
+    if (systab_entry.compare(0, key.size(), key) != 0) {
+        return false;
+    }
+    const char* value_begin = systab_entry.c_str() + key.size();
+    char* value_end = nullptr;
+    address = std::strtoull(value_begin, &value_end, 0);
+    return (value_end != value_begin) && (0 != address);
+}
+
+
+} // namespace
+
 SMBiosImpl::SMBiosImpl()
 {
-    compose_native_smbios_table();
+    compose_native_smbios_table(SMBiosSource::None);
+}
+
+SMBiosImpl::SMBiosImpl(SMBiosSource source, const std::string& root_path) : root_path_(root_path)
+{
+    compose_native_smbios_table(source);
+}
+
+SMBiosImpl::SMBiosImpl(const std::string& root_path) : root_path_(root_path)
+{
 }
 
 SMBiosImpl::~SMBiosImpl()
@@ -23,13 +78,16 @@ SMBiosImpl::~SMBiosImpl()
 
 bool SMBiosImpl::smbios_read_success() const
 {
-    return !table_buffer_.empty();
+    return !table_buffer_.empty() || (nullptr != mapped_table_base_);
 }
 
 const uint8_t* SMBiosImpl::get_table_base() const
 {
+    if (mapped_table_base_) {
+        return mapped_table_base_;
+    }
     // do not contain system-specific table information
-    return &table_buffer_[0];
+    return table_buffer_.empty() ? nullptr : &table_buffer_[0];
 }
 
 
@@ -40,86 +98,233 @@ void SMBiosImpl::read_from_physical_memory(std::vector<uint8_t>& physical_memory
 
 size_t SMBiosImpl::get_major_version() const
 {
+    if (entry_point_info_.anchor_type != SMBiosAnchorType::NoHeader) {
+        return entry_point_info_.major_version;
+    }
     return std::numeric_limits<size_t>::max();
 }
 
 size_t SMBiosImpl::get_minor_version() const
 {
+    if (entry_point_info_.anchor_type != SMBiosAnchorType::NoHeader) {
+        return entry_point_info_.minor_version;
+    }
     return std::numeric_limits<size_t>::max();
 }
 
+const std::vector<uint8_t>& SMBiosImpl::get_entry_point() const
+{
+    return entry_point_buffer_;
+}
+
 size_t SMBiosImpl::get_table_size() const
 {
+    if (mapped_table_base_) {
+        return mapped_table_size_;
+    }
     // do not contain system-specific table information
-    table_buffer_.size();
+    return table_buffer_.size();
 }
 
-void SMBiosImpl::compose_native_smbios_table()
+SMBiosImpl::SMBiosImpl(const std::set<uint8_t>& types, const std::string& root_path) : root_path_(root_path)
 {
-    if(sysfs_table_exists()){
-        reading_from_sysfs();
+    reading_from_sysfs_entries(types);
+}
+
+void SMBiosImpl::compose_native_smbios_table(SMBiosSource source)
+{
+    const bool any_source = (SMBiosSource::None == source);
+    if((any_source || SMBiosSource::SysFS == source) && sysfs_table_exists() && reading_from_sysfs()){
         return;
     }
-    if(efi_table_exists()){
-        reading_from_efi();
+    uint64_t efi_entry_point{};
+    if((any_source || SMBiosSource::EFI == source)
+            && efi_entry_point_address(efi_entry_point) && reading_from_efi(efi_entry_point)){
         return;
     }
 }
 
-bool SMBiosImpl::sysfs_table_exists() const
+std::string SMBiosImpl::rooted_path(const std::string& path) const
 {
-#if 1
-    return false;
-#else
-    // TODO: implement on Linux with sysfs-based SMBIOS
-    std::string smbios_filename("/sys/firmware/dmi/tables/smbios_entry_point");
-
-    std::cout << "Read SMBIOS entry point\n";
-    std::ifstream smbios_file(smbios_filename, std::ios::binary);
-    if(!smbios_file.is_open()){
-        return false;
-    }
+    return make_rooted_path(root_path_, path);
+}
 
-    std::istream_iterator<uint8_t> start(smbios_file), end;
-    std::vector<uint8_t> smbios_anchor(start, end);
-    std::cout << "Read " << smbios_anchor.size() << " bytes" << std::endl;
-#endif
+bool SMBiosImpl::sysfs_table_exists() const
+{
+    // both files are root-readable by default, but could be opened for everyone by udev rules
+    return (0 == access(rooted_path(sysfs_entry_point_path).c_str(), R_OK))
+            && (0 == access(rooted_path(sysfs_table_path).c_str(), R_OK));
 }
 
-bool SMBiosImpl::efi_table_exists() const
+bool SMBiosImpl::efi_entry_point_address(uint64_t& entry_point_address) const
 {
     // try these places for EFI entry point
     const std::string filename1("/sys/firmware/efi/systab");
     const std::string filename2("/proc/efi/systab");
     std::ifstream systab_file;
 
-    systab_file.open(filename1);
+    systab_file.open(rooted_path(filename1));
     if(!systab_file.is_open()){
-        systab_file.open(filename2);
+        systab_file.open(rooted_path(filename2));
     }
 
     if(!systab_file.is_open()){
         return false;
     }
 
+    // SMBIOS3 entry point could be listed together with the legacy one, prefer SMBIOS3
+    uint64_t smbios3_address{};
+    uint64_t smbios_address{};
     std::string systab_entry;
     while(getline(systab_file, systab_entry)){
-        if(systab_entry.find("SMBIOS") != std::string::npos){
-            return true;
+        if(parse_systab_address(systab_entry, "SMBIOS3=", smbios3_address)){
+            break;
         }
+        parse_systab_address(systab_entry, "SMBIOS=", smbios_address);
     }
 
-    return false;
+    entry_point_address = smbios3_address ? smbios3_address : smbios_address;
+    return 0 != entry_point_address;
 }
 
-void SMBiosImpl::reading_from_efi()
+bool SMBiosImpl::probe_entry_point(SMBiosSource source, const std::string& root_path, SMBiosEntryPointInfo& entry_point_info)
 {
-    // TODO: implement on Mac
+    SMBiosImpl probe(root_path);
+    uint64_t efi_entry_point{};
+    switch (source) {
+    case SMBiosSource::SysFS:
+    case SMBiosSource::SysFSEntries:
+        return probe.read_sysfs_entry_point(entry_point_info);
+    case SMBiosSource::EFI:
+        return probe.efi_entry_point_address(efi_entry_point)
+                && probe.read_efi_entry_point(efi_entry_point, entry_point_info);
+    default:
+        return false;
+    }
 }
 
-void SMBiosImpl::reading_from_sysfs()
+bool SMBiosImpl::read_sysfs_entry_point(SMBiosEntryPointInfo& entry_point_info)
 {
-    // TODO: implement on Linux with sysfs-based SMBIOS
+    if (!read_file_contents(rooted_path(sysfs_entry_point_path), entry_point_buffer_)
+            || !parse_smbios_entry_point(entry_point_buffer_.data(), entry_point_buffer_.size(), entry_point_info)) {
+        entry_point_buffer_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool SMBiosImpl::read_efi_entry_point(uint64_t entry_point_address, SMBiosEntryPointInfo& entry_point_info)
+{
+    try {
+        // entry point is tiny, keep own copy of it
+        // the longest one is 32-bit entry point
+        PhysicalMemory entry_point_memory(entry_point_address, sizeof(SMBIOSEntryPoint32),
+                                          PhysicalMemoryAccess::Auto, root_path_);
+        PhysicalMemoryView entry_point = entry_point_memory.get_memory_view(0, sizeof(SMBIOSEntryPoint32));
+        entry_point_buffer_.assign(entry_point.begin(), entry_point.end());
+    }
+    catch (const std::exception&) {
+        // /dev/mem is not accessible, leave fallback to the caller
+        entry_point_buffer_.clear();
+        return false;
+    }
+
+    if (!parse_smbios_entry_point(entry_point_buffer_.data(), entry_point_buffer_.size(), entry_point_info)
+            || (0 == entry_point_info.table_length)) {
+        entry_point_buffer_.clear();
+        return false;
+    }
+    return true;
+}
+
+bool SMBiosImpl::reading_from_efi(uint64_t entry_point_address)
+{
+    SMBiosEntryPointInfo entry_point_info;
+    if (!read_efi_entry_point(entry_point_address, entry_point_info)) {
+        return false;
+    }
+
+    try {
+        // index the table right inside the mapping, no intermediate dump
+        table_memory_ = std::make_unique<PhysicalMemory>(entry_point_info.table_address, entry_point_info.table_length,
+                                                         PhysicalMemoryAccess::Auto, root_path_);
+        PhysicalMemoryView table_view = table_memory_->get_memory_view(0, entry_point_info.table_length);
+        if (table_view.empty()) {
+            table_memory_.reset();
+            entry_point_buffer_.clear();
+            return false;
+        }
+        mapped_table_base_ = table_view.data();
+        mapped_table_size_ = table_view.size();
+        entry_point_info_ = entry_point_info;
+        return true;
+    }
+    catch (const std::exception&) {
+        // /dev/mem is not accessible, leave fallback to the caller
+        table_memory_.reset();
+        entry_point_buffer_.clear();
+        return false;
+    }
+}
+
+bool SMBiosImpl::reading_from_sysfs()
+{
+    SMBiosEntryPointInfo entry_point_info;
+    if (!read_sysfs_entry_point(entry_point_info)) {
+        return false;
+    }
+
+    // sysfs binary attributes do not support mmap(), so read directly
+    // into the table buffer, pre-sized with the table length reported by the kernel
+    if (!read_file_contents(rooted_path(sysfs_table_path), table_buffer_)) {
+        entry_point_buffer_.clear();
+        return false;
+    }
+
+    entry_point_info_ = entry_point_info;
+    return true;
+}
+
+bool SMBiosImpl::reading_from_sysfs_entries(const std::set<uint8_t>& types)
+{
+    std::vector<std::string> entry_names;
+    if (types.empty() || !list_directory(rooted_path(sysfs_entries_path), entry_names)) {
+        return false;
+    }
+
+    // only names are matched, unwanted structures are never read
+    std::vector<std::pair<unsigned long, unsigned long>> wanted_entries;
+    for (const std::string& entry_name : entry_names) {
+        unsigned long type{};
+        unsigned long instance{};
+        // end of table marker would hide the following types, the only one is appended at the end
+        if (parse_entry_name(entry_name, type, instance) && types.count(static_cast<uint8_t>(type))
+                && static_cast<unsigned long>(SMBios::EndOfTable) != type) {
+            wanted_entries.emplace_back(type, instance);
+        }
+    }
+    std::sort(wanted_entries.begin(), wanted_entries.end());
+
+    std::vector<uint8_t> structure;
+    for (const auto& entry : wanted_entries) {
+        const std::string raw_path = rooted_path(sysfs_entries_path) + '/' + std::to_string(entry.first)
+                + '-' + std::to_string(entry.second) + "/raw";
+        if (!read_file_contents(raw_path, structure)) {
+            table_buffer_.clear();
+            return false;
+        }
+        table_buffer_.insert(table_buffer_.end(), structure.begin(), structure.end());
+    }
+    const uint8_t end_of_table[] = {SMBios::EndOfTable, 4, 0xFF, 0xFF, 0, 0};
+    table_buffer_.insert(table_buffer_.end(), std::begin(end_of_table), std::end(end_of_table));
+
+    // entry point is tiny, version is optional
+    SMBiosEntryPointInfo entry_point_info;
+    if (read_sysfs_entry_point(entry_point_info)) {
+        entry_point_info_ = entry_point_info;
+    }
+    // no wanted structures is the answer as well, the whole table is not needed to tell it
+    return true;
 }
 
 #endif //defined(__linux__) || defined (__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__) || defined(__sun)
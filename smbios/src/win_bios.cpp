@@ -14,11 +14,22 @@ SMBiosImpl::SMBiosImpl() : native_system_information_(std::make_unique<smbios::N
     compose_native_smbios_table();
 }
 
+SMBiosImpl::SMBiosImpl(SMBiosSource source, const std::string&) : native_system_information_(std::make_unique<smbios::NativeSystemInformation>())
+{
+    if (SMBiosSource::FirmwareTable == source || SMBiosSource::None == source) {
+        compose_native_smbios_table();
+    }
+}
+
 SMBiosImpl::~SMBiosImpl()
 {
 
 }
 
+SMBiosImpl::SMBiosImpl(const std::set<uint8_t>&, const std::string&) : native_system_information_(std::make_unique<smbios::NativeSystemInformation>())
+{
+}
+
 bool SMBiosImpl::smbios_read_success() const
 {
     return !table_buffer_.empty() && smbios_data_;
@@ -55,6 +66,11 @@ size_t SMBiosImpl::get_minor_version() const
     return std::numeric_limits<size_t>::max();
 }
 
+const std::vector<uint8_t>& SMBiosImpl::get_entry_point() const
+{
+    return entry_point_buffer_;
+}
+
 size_t SMBiosImpl::get_table_size() const
 {
     if (table_buffer_.empty()) {
@@ -73,6 +89,24 @@ void SMBiosImpl::read_from_physical_memory(std::vector<uint8_t>& physical_memory
     table_buffer_ = std::move(physical_memory_dump);
 }
 
+bool SMBiosImpl::probe_entry_point(SMBiosSource source, const std::string&, SMBiosEntryPointInfo& entry_point_info)
+{
+    if (SMBiosSource::FirmwareTable != source) {
+        return false;
+    }
+
+    // raw SMBIOS data header is returned only together with the table
+    SMBiosImpl probe(source);
+    if (!probe.smbios_read_success()) {
+        return false;
+    }
+    entry_point_info = SMBiosEntryPointInfo{};
+    entry_point_info.major_version = probe.get_major_version();
+    entry_point_info.minor_version = probe.get_minor_version();
+    entry_point_info.table_length = probe.get_table_size();
+    return true;
+}
+
 bool SMBiosImpl::is_ntdll_compatible() const
 {
     FARPROC system_firmware_call = GetProcAddress(GetModuleHandle("kernel32.dll"), "GetSystemFirmwareTable");
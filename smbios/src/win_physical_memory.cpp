@@ -1,5 +1,6 @@
 #if defined(_WIN32) || defined(_WIN64)
 #include <smbios/win_physical_memory.h>
+#include <smbios/physical_memory.h>
 #include <smbios/win_native_api_helper.h>
 #include <smbios/win_handle_ptr.h>
 
@@ -34,10 +35,11 @@ NativePhysicalMemory::NativePhysicalMemory()
 {
 }
 
-NativePhysicalMemory::NativePhysicalMemory(size_t base, size_t length) 
+NativePhysicalMemory::NativePhysicalMemory(size_t base, size_t length, PhysicalMemoryAccess access,
+                                           const std::string& root_path)
     : physical_memory_device_(std::make_unique<WinHandlePtr>())
 {
-    map_physical_memory(base, length);
+    map_physical_memory(base, length, access, root_path);
 }
 
 NativePhysicalMemory::~NativePhysicalMemory()
@@ -45,7 +47,7 @@ NativePhysicalMemory::~NativePhysicalMemory()
     unmap_memory();
 }
 
-void NativePhysicalMemory::map_physical_memory(size_t base, size_t length)
+void NativePhysicalMemory::map_physical_memory(size_t base, size_t length, PhysicalMemoryAccess, const std::string&)
 {
     // Load NTDLL entry points
     if (!is_ntdll_compatible()) {
@@ -79,6 +81,7 @@ void NativePhysicalMemory::map_physical_memory(size_t base, size_t length)
     if (!NT_SUCCESS(map_view_status)) {
         throw std::system_error(GetLastError(), std::system_category());
     }
+    mapped_length_ = length;
 }
 
 bool NativePhysicalMemory::is_mapped() const
@@ -88,11 +91,17 @@ bool NativePhysicalMemory::is_mapped() const
 
 std::vector<uint8_t> NativePhysicalMemory::get_memory_dump(size_t offset, size_t length) const
 {
-    std::vector<uint8_t> memory_dump(length);
     uint8_t* aligned_begin = virtual_address_ - page_offset_;
     uint8_t* aligned_end = aligned_begin + length;
-    memory_dump.assign(aligned_begin, aligned_end);
-    return std::move(memory_dump);
+    return std::vector<uint8_t>(aligned_begin, aligned_end);
+}
+
+PhysicalMemoryView NativePhysicalMemory::get_memory_view(size_t offset, size_t length) const
+{
+    if (!is_mapped() || (offset + length) > mapped_length_) {
+        return PhysicalMemoryView();
+    }
+    return PhysicalMemoryView(get_memory_offset(page_offset_ + offset), length);
 }
 
 uint8_t* NativePhysicalMemory::get_memory_offset(size_t offset) const
@@ -100,6 +109,11 @@ uint8_t* NativePhysicalMemory::get_memory_offset(size_t offset) const
     return virtual_address_ - page_offset_ + offset;
 }
 
+size_t NativePhysicalMemory::get_page_offset() const
+{
+    return page_offset_;
+}
+
 bool NativePhysicalMemory::is_ntdll_compatible() const
 {
     // RtlInitUnicodeString 
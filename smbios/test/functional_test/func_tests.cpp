@@ -1,8 +1,20 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <boost/filesystem.hpp>
 #include <smbios/smbios.h>
 #include <smbios/smbios_entry_factory.h>
+#include <smbios/smbios_entry_point.h>
+#include <smbios/smbios_anchor_scanner.h>
+#include <smbios/smbios_table_stream.h>
+#include <smbios/system_identity.h>
+#include <smbios/raw_smbios_data.h>
+#include <smbios/smbios_snapshot.h>
+#include <smbios/smbios_cache.h>
+#include <smbios/shared_memory.h>
 
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/unit_test.hpp>
@@ -18,6 +30,228 @@ using namespace smbios;
 
 BOOST_AUTO_TEST_SUITE(SmbiosFunctionalTests);
 
+namespace {
+
+/// Make entry point checksum (at checksum_offset) zero the sum of range
+void fix_checksum(std::vector<uint8_t>& buffer, size_t start, size_t length, size_t checksum_offset)
+{
+    buffer[checksum_offset] = 0;
+    uint8_t sum{};
+    for (size_t i = start; i < start + length; ++i) {
+        sum += buffer[i];
+    }
+    buffer[checksum_offset] = static_cast<uint8_t>(0x100 - sum);
+}
+
+/// Synthetic SMBIOS 3.x entry point
+std::vector<uint8_t> make_entry_point64(uint64_t table_address, uint32_t table_length)
+{
+    std::vector<uint8_t> entry_point(sizeof(SMBIOSEntryPoint64));
+    SMBIOSEntryPoint64* ep = reinterpret_cast<SMBIOSEntryPoint64*>(entry_point.data());
+    std::copy_n("_SM3_", 5, ep->entry_point_anchor);
+    ep->entry_point_length = sizeof(SMBIOSEntryPoint64);
+    ep->major_version = 3;
+    ep->minor_version = 2;
+    ep->entry_point_revision = 1;
+    ep->max_structure_size = table_length;
+    ep->structure_table_address = table_address;
+    fix_checksum(entry_point, 0, entry_point.size(), 5);
+    return entry_point;
+}
+
+/// Synthetic SMBIOS 2.x entry point
+std::vector<uint8_t> make_entry_point32(uint32_t table_address, uint16_t table_length, uint16_t structures)
+{
+    std::vector<uint8_t> entry_point(sizeof(SMBIOSEntryPoint32));
+    SMBIOSEntryPoint32* ep = reinterpret_cast<SMBIOSEntryPoint32*>(entry_point.data());
+    std::copy_n("_SM_", 4, ep->entry_point_anchor);
+    ep->entry_point_length = sizeof(SMBIOSEntryPoint32);
+    ep->major_version = 2;
+    ep->minor_version = 8;
+    std::copy_n("_DMI_", 5, ep->intermediate_anchor);
+    ep->structure_table_length = table_length;
+    ep->structure_table_address = table_address;
+    ep->smbios_structures_number = structures;
+    ep->smbios_bcd_revision = 0x28;
+    fix_checksum(entry_point, 0x10, 0x0F, 0x15);
+    fix_checksum(entry_point, 0, entry_point.size(), 4);
+    return entry_point;
+}
+
+/// Synthetic legacy DMI entry point
+std::vector<uint8_t> make_entry_point_legacy(uint32_t table_address, uint16_t table_length, uint16_t structures)
+{
+    std::vector<uint8_t> entry_point(sizeof(SMBIOSEntryPointLegacy));
+    SMBIOSEntryPointLegacy* ep = reinterpret_cast<SMBIOSEntryPointLegacy*>(entry_point.data());
+    std::copy_n("_DMI_", 5, ep->entry_point_anchor);
+    ep->structure_table_length = table_length;
+    ep->structure_table_address = table_address;
+    ep->smbios_structures_number = structures;
+    ep->smbios_bcd_revision = 0x21;
+    fix_checksum(entry_point, 0, entry_point.size(), 5);
+    return entry_point;
+}
+
+/// Append structure with formatted area of given length and strings section
+void append_structure(std::vector<uint8_t>& table, uint8_t type, uint8_t length, uint16_t handle,
+                      const std::vector<std::string>& strings)
+{
+    table.push_back(type);
+    table.push_back(length);
+    table.push_back(static_cast<uint8_t>(handle & 0xFF));
+    table.push_back(static_cast<uint8_t>(handle >> 8));
+    for (uint8_t i = 4; i < length; ++i) {
+        // string indexes, if any, start right after the header
+        table.push_back(static_cast<size_t>(i - 3) <= strings.size() ? i - 3 : 0);
+    }
+    for (const std::string& dmi_string : strings) {
+        table.insert(table.end(), dmi_string.begin(), dmi_string.end());
+        table.push_back(0);
+    }
+    if (strings.empty()) {
+        table.push_back(0);
+    }
+    table.push_back(0);
+}
+
+/// Synthetic table: BIOS Information, System Information, memory devices, end of table
+std::vector<uint8_t> make_smbios_table(size_t memory_devices = 2)
+{
+    std::vector<uint8_t> table;
+    append_structure(table, SMBios::BIOSInformation, 0x18, 0, {"Vendor", "1.0", "01/01/2020"});
+    append_structure(table, SMBios::SystemInformation, 0x1B, 1, {"Maker", "Product", "1", "Serial"});
+    for (size_t i = 0; i < memory_devices; ++i) {
+        append_structure(table, SMBios::MemoryDevice, 0x15, static_cast<uint16_t>(0x10 + i), {"DIMM"});
+    }
+    append_structure(table, SMBios::EndOfTable, 4, 0xFFFF, {});
+    return table;
+}
+
+/// Write bytes to the file, create parent directories
+void write_file(const boost::filesystem::path& path, const std::vector<uint8_t>& contents)
+{
+    boost::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path.string(), std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(contents.data()), contents.size());
+}
+
+/// Write bytes to the temporary file
+std::string write_temp_file(const std::string& name, const std::vector<uint8_t>& contents)
+{
+    boost::filesystem::path path = boost::filesystem::temp_directory_path() / name;
+    write_file(path, contents);
+    return path.string();
+}
+
+/// Physical address of the table in fixture '/dev/mem'
+const uint32_t fixture_table_address = 0x80000;
+
+/// Fixture filesystem root with the same table published through sysfs tables and entries,
+/// EFI system table and '/dev/mem' image (32-bit entry point in the legacy BIOS area)
+boost::filesystem::path make_fixture_root(const std::vector<uint8_t>& table)
+{
+    boost::filesystem::path root = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path("smbios_root_%%%%%%%%");
+
+    write_file(root / "sys/firmware/dmi/tables/smbios_entry_point",
+               make_entry_point64(0, static_cast<uint32_t>(table.size())));
+    write_file(root / "sys/firmware/dmi/tables/DMI", table);
+
+    // one file per structure, instances are counted per type
+    SMBios smbios(table.data(), table.size());
+    std::map<size_t, size_t> instances;
+    std::vector<const uint8_t*> structures;
+    for (const DMIHeader& header : smbios) {
+        structures.push_back(header.data);
+    }
+    structures.push_back(table.data() + table.size());
+    for (size_t i = 0; i + 1 < structures.size(); ++i) {
+        size_t type = structures[i][0];
+        std::string entry_name = std::to_string(type) + '-' + std::to_string(instances[type]++);
+        write_file(root / "sys/firmware/dmi/entries" / entry_name / "raw",
+                   std::vector<uint8_t>(structures[i], structures[i + 1]));
+    }
+
+    const uint32_t entry_point_address = 0xF0100;
+    std::vector<uint8_t> physical_memory(0x100000);
+    std::vector<uint8_t> entry_point = make_entry_point32(fixture_table_address, static_cast<uint16_t>(table.size()), 5);
+    std::copy(entry_point.begin(), entry_point.end(), physical_memory.begin() + entry_point_address);
+    std::copy(table.begin(), table.end(), physical_memory.begin() + fixture_table_address);
+    write_file(root / "dev/mem", physical_memory);
+
+    const std::string systab = "ACPI20=0xe0000\nSMBIOS=0xf0100\n";
+    write_file(root / "sys/firmware/efi/systab", std::vector<uint8_t>(systab.begin(), systab.end()));
+
+    // product_uuid and product_serial are root-only, leave them to the table
+    const std::string vendor = "Maker\n";
+    write_file(root / "sys/class/dmi/id/sys_vendor", std::vector<uint8_t>(vendor.begin(), vendor.end()));
+    return root;
+}
+
+/// Table stream over the memory buffer instead of physical memory
+class BufferTableStream : public SMBiosTableStream
+{
+public:
+    BufferTableStream(const std::vector<uint8_t>& table, size_t window_size)
+        : SMBiosTableStream(0, table.size(), window_size), table_(table) {}
+
+protected:
+    PhysicalMemoryView map_window(size_t offset, size_t length) override
+    {
+        // copy, so that reads beyond the window would be caught by sanitizers
+        window_.assign(table_.begin() + offset, table_.begin() + offset + length);
+        return PhysicalMemoryView(window_.data(), window_.size());
+    }
+
+private:
+    const std::vector<uint8_t>& table_;
+    std::vector<uint8_t> window_;
+};
+
+} // namespace
+
+/// Entry point validation does not depend on the table source
+BOOST_AUTO_TEST_CASE(SMBiosEntryPointTestCase)
+{
+    SMBiosEntryPointInfo info;
+    std::vector<uint8_t> entry_point64 = make_entry_point64(0x7F000000, 0x1234);
+    BOOST_CHECK(parse_smbios_entry_point(entry_point64.data(), entry_point64.size(), info));
+    BOOST_CHECK_EQUAL(info.anchor_type, SMBiosAnchorType::SMBios64);
+    BOOST_CHECK_EQUAL(info.major_version, 3u);
+    BOOST_CHECK_EQUAL(info.table_address, 0x7F000000u);
+    BOOST_CHECK_EQUAL(info.table_length, 0x1234u);
+
+    std::vector<uint8_t> entry_point32 = make_entry_point32(0xE0000, 0x400, 12);
+    BOOST_CHECK(parse_smbios_entry_point(entry_point32.data(), entry_point32.size(), info));
+    BOOST_CHECK_EQUAL(info.anchor_type, SMBiosAnchorType::SMBios32);
+    BOOST_CHECK_EQUAL(info.minor_version, 8u);
+    BOOST_CHECK_EQUAL(info.table_address, 0xE0000u);
+    BOOST_CHECK_EQUAL(info.structures_number, 12u);
+    BOOST_CHECK_EQUAL(info.bcd_revision, 0x28u);
+
+    std::vector<uint8_t> entry_point_legacy = make_entry_point_legacy(0xF1000, 0x200, 7);
+    BOOST_CHECK(parse_smbios_entry_point(entry_point_legacy.data(), entry_point_legacy.size(), info));
+    BOOST_CHECK_EQUAL(info.anchor_type, SMBiosAnchorType::SMBiosLegacy);
+    BOOST_CHECK_EQUAL(info.entry_point_length, 0x0Fu);
+    BOOST_CHECK_EQUAL(info.major_version, 2u);
+    BOOST_CHECK_EQUAL(info.minor_version, 1u);
+    BOOST_CHECK_EQUAL(info.table_address, 0xF1000u);
+    BOOST_CHECK_EQUAL(info.table_length, 0x200u);
+    BOOST_CHECK_EQUAL(info.structures_number, 7u);
+    BOOST_CHECK_EQUAL(info.bcd_revision, 0x21u);
+
+    // intermediate part of 32-bit entry point is a valid legacy entry point
+    BOOST_CHECK(parse_smbios_entry_point(entry_point32.data() + 0x10, 0x0F, info));
+    BOOST_CHECK_EQUAL(info.anchor_type, SMBiosAnchorType::SMBiosLegacy);
+    BOOST_CHECK_EQUAL(info.minor_version, 8u);
+
+    // broken checksum and truncated entry point
+    BOOST_CHECK(!parse_smbios_entry_point(entry_point_legacy.data(), 0x0E, info));
+    entry_point32[0x18] ^= 0xFF;
+    BOOST_CHECK(!parse_smbios_entry_point(entry_point32.data(), entry_point32.size(), info));
+    BOOST_CHECK(!parse_smbios_entry_point(entry_point64.data(), 0x10, info));
+}
+
 
 /// Check consistent information after creation
 BOOST_AUTO_TEST_CASE(SMBiosCreationTestCase)
@@ -61,4 +295,714 @@ BOOST_AUTO_TEST_CASE(SMBiosIterationTestCase)
 }
 
 
+/// Only wanted structure types are indexed, from per-type entries or from the whole table
+BOOST_AUTO_TEST_CASE(SMBiosWantedTypesTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table(3);
+    boost::filesystem::path root = make_fixture_root(table);
+    const std::set<uint8_t> types{SMBios::BIOSInformation, SMBios::MemoryDevice};
+
+    for (SMBiosSource source : {SMBiosSource::SysFSEntries, SMBiosSource::SysFS}) {
+        if (SMBiosSource::SysFS == source) {
+            // no per-type entries, the whole table is walked
+            boost::filesystem::remove_all(root / "sys/firmware/dmi/entries");
+        }
+
+        SMBios smbios(types, root.string());
+        BOOST_CHECK(smbios.get_acquisition_report().source == source);
+        size_t headers = 0;
+        for (const DMIHeader& header : smbios) {
+            BOOST_CHECK(header.type == SMBios::BIOSInformation || header.type == SMBios::MemoryDevice);
+            ++headers;
+        }
+        BOOST_CHECK_EQUAL(headers, 4u);
+        BOOST_CHECK_EQUAL(smbios.get_structures_count(), 4u);
+        BOOST_CHECK_EQUAL(smbios.get_structures_count(SMBios::BIOSInformation), 1u);
+        BOOST_CHECK_EQUAL(smbios.get_structures_count(SMBios::MemoryDevice), 3u);
+        BOOST_CHECK_EQUAL(smbios.get_structures_count(SMBios::SystemInformation), 0u);
+    }
+    PhysicalMemory::release_cached_mappings();
+    boost::filesystem::remove_all(root);
+
+    // end of table entry does not hide OEM types which follow it
+    std::vector<uint8_t> oem_table;
+    append_structure(oem_table, SMBios::BIOSInformation, 0x18, 0, {"Vendor"});
+    append_structure(oem_table, 0xC0, 0x08, 1, {"OEM"});
+    append_structure(oem_table, SMBios::EndOfTable, 4, 0xFFFF, {});
+    root = make_fixture_root(oem_table);
+    write_file(root / "sys/firmware/dmi/entries/127-0/raw", {SMBios::EndOfTable, 4, 0xFF, 0xFF, 0, 0});
+    SMBios oem(std::set<uint8_t>{SMBios::EndOfTable, 0xC0}, root.string());
+    BOOST_CHECK(oem.get_acquisition_report().source == SMBiosSource::SysFSEntries);
+    BOOST_CHECK_EQUAL(oem.get_structures_count(), 1u);
+    BOOST_CHECK_EQUAL(oem.get_structures_count(0xC0), 1u);
+
+    // no wanted structures: nothing else is read
+    SMBios missing(std::set<uint8_t>{SMBios::MemoryDevice}, root.string());
+    BOOST_CHECK(missing.get_acquisition_report().source == SMBiosSource::SysFSEntries);
+    BOOST_CHECK_EQUAL(missing.get_structures_count(), 0u);
+    BOOST_CHECK(missing.begin() == missing.end());
+
+    PhysicalMemory::release_cached_mappings();
+    boost::filesystem::remove_all(root);
+}
+
+/// Dump file is indexed in place
+BOOST_AUTO_TEST_CASE(SMBiosDumpFileTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    std::string dump_path = write_temp_file("smbios_func_test.bin", table);
+
+    SMBios smbios(dump_path, SMBiosVersion{3, 2});
+    BOOST_CHECK_EQUAL(smbios.get_smbios_version().major_version, 3);
+    BOOST_CHECK_EQUAL(smbios.get_table_size(), table.size());
+    BOOST_CHECK_EQUAL(smbios.get_structures_count(), 5u);
+    BOOST_CHECK_EQUAL(smbios.get_structures_count(SMBios::MemoryDevice), 2u);
+    BOOST_CHECK_EQUAL(smbios.get_structures_count(SMBios::BIOSInformation), 1u);
+    BOOST_CHECK_EQUAL(smbios.get_structures_count(SMBios::EndOfTable), 0u);
+
+    std::vector<size_t> types;
+    for (const DMIHeader& header : smbios) {
+        types.push_back(header.get_type());
+    }
+    BOOST_CHECK_EQUAL(types.size(), 4u);
+    BOOST_CHECK_EQUAL(types.front(), static_cast<size_t>(SMBios::BIOSInformation));
+
+    BOOST_CHECK_THROW(SMBios("/nonexistent/smbios.bin"), std::exception);
+    boost::filesystem::remove(dump_path);
+}
+
+/// Caller-owned memory is indexed in place, entry point provides version
+BOOST_AUTO_TEST_CASE(SMBiosByteSpanTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    std::vector<uint8_t> entry_point = make_entry_point64(0, static_cast<uint32_t>(table.size()));
+
+    SMBios smbios(table.data(), table.size(), entry_point.data(), entry_point.size());
+    BOOST_CHECK_EQUAL(smbios.get_smbios_version().major_version, 3);
+    BOOST_CHECK_EQUAL(smbios.get_smbios_version().minor_version, 2);
+    BOOST_CHECK(smbios.get_table_base() == table.data());
+    BOOST_CHECK(!smbios.render_to_description().empty());
+
+    for (const DMIHeader& header : smbios) {
+        BOOST_CHECK(header.data >= table.data() && header.data < table.data() + table.size());
+    }
+
+    std::vector<uint8_t> entry_point_legacy = make_entry_point_legacy(0, static_cast<uint16_t>(table.size()), 5);
+    SMBios legacy_smbios(table.data(), table.size(), entry_point_legacy.data(), entry_point_legacy.size());
+    BOOST_CHECK_EQUAL(legacy_smbios.get_smbios_version().major_version, 2);
+    BOOST_CHECK_EQUAL(legacy_smbios.get_smbios_version().minor_version, 1);
+    BOOST_CHECK(!legacy_smbios.render_to_description().empty());
+
+    entry_point[5] ^= 0xFF;
+    BOOST_CHECK_THROW(SMBios(table.data(), table.size(), entry_point.data(), entry_point.size()), std::runtime_error);
+    BOOST_CHECK_THROW(SMBios(nullptr, 0), std::runtime_error);
+}
+
+/// dmidecode --dump-bin image keeps the entry point, so reload does not need the version
+BOOST_AUTO_TEST_CASE(SMBiosDumpBinTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    std::vector<uint8_t> entry_point32 = make_entry_point32(0xE0000, static_cast<uint16_t>(table.size()), 5);
+    std::vector<uint8_t> entry_point_legacy = make_entry_point_legacy(0xE0000, static_cast<uint16_t>(table.size()), 5);
+
+    // original entry point is relocated, synthesized for the source without entry point
+    for (const std::vector<uint8_t>& entry_point : {entry_point32, entry_point_legacy, std::vector<uint8_t>{}}) {
+        SMBios smbios(table.data(), table.size(), entry_point.empty() ? nullptr : entry_point.data(), entry_point.size());
+        std::vector<uint8_t> dump = smbios.make_dump_bin();
+        BOOST_CHECK_EQUAL(dump.size(), dump_bin_table_offset + table.size());
+        BOOST_CHECK(std::equal(table.begin(), table.end(), dump.begin() + dump_bin_table_offset));
+
+        SMBiosEntryPointInfo info;
+        BOOST_CHECK(parse_smbios_entry_point(dump.data(), dump_bin_table_offset, info));
+        BOOST_CHECK_EQUAL(info.table_address, dump_bin_table_offset);
+
+        std::string dump_path = write_temp_file("smbios_func_test_dump_bin.bin", dump);
+        SMBios dump_smbios(dump_path);
+        BOOST_CHECK_EQUAL(dump_smbios.get_smbios_version().major_version, entry_point.empty() ? 3 : 2);
+        BOOST_CHECK_EQUAL(dump_smbios.get_table_size(), table.size());
+        BOOST_CHECK_EQUAL(dump_smbios.get_structures_count(), smbios.get_structures_count());
+        boost::filesystem::remove(dump_path);
+    }
+
+    // firmware entry point of the native source is relocated with all its fields
+    boost::filesystem::path root = make_fixture_root(table);
+    AcquisitionPolicy policy;
+    policy.root_path = root.string();
+    for (SMBiosSource source : {SMBiosSource::SysFS, SMBiosSource::EFI}) {
+        policy.steps = {{source}};
+        std::vector<uint8_t> dump = SMBios(policy).make_dump_bin();
+        SMBiosEntryPointInfo info;
+        BOOST_REQUIRE(parse_smbios_entry_point(dump.data(), dump_bin_table_offset, info));
+        BOOST_CHECK(info.anchor_type == (SMBiosSource::SysFS == source ? SMBiosAnchorType::SMBios64 : SMBiosAnchorType::SMBios32));
+        BOOST_CHECK_EQUAL(info.minor_version, SMBiosSource::SysFS == source ? 2u : 8u);
+        BOOST_CHECK_EQUAL(info.structures_number, SMBiosSource::SysFS == source ? 0u : 5u);
+        BOOST_CHECK_EQUAL(info.table_address, dump_bin_table_offset);
+    }
+    PhysicalMemory::release_cached_mappings();
+    boost::filesystem::remove_all(root);
+
+    // 32-bit entry point could not describe 2.x table longer than 64K
+    std::vector<uint8_t> large_table = make_smbios_table(3000);
+    BOOST_REQUIRE_GT(large_table.size(), 0x10000u);
+    std::vector<uint8_t> raw_data = {0, 2, 8, 0};
+    for (size_t i = 0; i < 4; ++i) {
+        raw_data.push_back(static_cast<uint8_t>(large_table.size() >> (8 * i)));
+    }
+    raw_data.insert(raw_data.end(), large_table.begin(), large_table.end());
+    BOOST_CHECK_THROW(SMBios::from_raw_smbios_data(raw_data.data(), raw_data.size()).make_dump_bin(), std::runtime_error);
+
+    // table address beyond the file end
+    std::vector<uint8_t> dump(dump_bin_table_offset, 0);
+    std::copy(entry_point32.begin(), entry_point32.end(), dump.begin());
+    std::string dump_path = write_temp_file("smbios_func_test_dump_bin.bin", dump);
+    BOOST_CHECK_THROW(SMBios{dump_path}, std::runtime_error);
+    boost::filesystem::remove(dump_path);
+}
+
+/// Snapshot is loaded with the same headers, version and source without the table scan
+BOOST_AUTO_TEST_CASE(SMBiosSnapshotTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table(8);
+    std::vector<uint8_t> entry_point = make_entry_point64(0, static_cast<uint32_t>(table.size()));
+    SMBios smbios(table.data(), table.size(), entry_point.data(), entry_point.size());
+
+    std::vector<uint8_t> snapshot = smbios.make_snapshot();
+    SMBiosSnapshotInfo info;
+    BOOST_CHECK(parse_smbios_snapshot(snapshot.data(), snapshot.size(), info));
+    BOOST_CHECK_EQUAL(info.index_count, 10u);
+    BOOST_CHECK(info.source == SMBiosSource::Memory);
+    BOOST_CHECK_EQUAL(info.entry_point_length, entry_point.size());
+
+    std::string snapshot_path = write_temp_file("smbios_func_test_snapshot.bin", snapshot);
+    SMBios loaded(snapshot_path);
+    BOOST_CHECK(loaded.get_acquisition_report().source == SMBiosSource::DumpFile);
+    BOOST_CHECK(loaded.get_acquisition_report().snapshot_source == SMBiosSource::Memory);
+    BOOST_CHECK_EQUAL(loaded.get_smbios_version().major_version, 3);
+    BOOST_CHECK_EQUAL(loaded.get_smbios_version().minor_version, 2);
+    BOOST_CHECK_EQUAL(loaded.get_structures_count(), smbios.get_structures_count());
+    BOOST_CHECK_EQUAL(loaded.get_structures_count(SMBios::MemoryDevice), 8u);
+    BOOST_CHECK(!loaded.render_to_description().empty());
+
+    // snapshot of the loaded snapshot keeps the original source
+    std::vector<uint8_t> resnapshot = loaded.make_snapshot();
+    BOOST_CHECK(parse_smbios_snapshot(resnapshot.data(), resnapshot.size(), info));
+    BOOST_CHECK(info.source == SMBiosSource::Memory);
+
+    auto indexed = smbios.begin();
+    size_t headers = 0;
+    for (const DMIHeader& header : loaded) {
+        BOOST_CHECK_EQUAL(header.type, (*indexed).type);
+        BOOST_CHECK_EQUAL(header.handle, (*indexed).handle);
+        BOOST_CHECK(std::equal(header.data, header.data + header.length, (*indexed).data));
+        ++indexed;
+        ++headers;
+    }
+    BOOST_CHECK_EQUAL(headers, 10u);
+    boost::filesystem::remove(snapshot_path);
+
+    // index entry beyond the table, truncated snapshot
+    std::vector<uint8_t> broken = snapshot;
+    const size_t index_offset = reinterpret_cast<const SMBiosSnapshotHeader*>(snapshot.data())->index_offset;
+    reinterpret_cast<SMBiosSnapshotIndexEntry*>(&broken[index_offset])->offset = 0xFFFF;
+    BOOST_CHECK(!parse_smbios_snapshot(broken.data(), broken.size(), info));
+    snapshot.resize(snapshot.size() - 1);
+    BOOST_CHECK(!parse_smbios_snapshot(snapshot.data(), snapshot.size(), info));
+    snapshot_path = write_temp_file("smbios_func_test_snapshot.bin", snapshot);
+    BOOST_CHECK_THROW(SMBios{snapshot_path}, std::runtime_error);
+    boost::filesystem::remove(snapshot_path);
+}
+
+/// Windows firmware table blob is indexed in place, version is taken from its header
+BOOST_AUTO_TEST_CASE(RawSMBiosDataTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    std::vector<uint8_t> raw_data = {0, 3, 1, 0};
+    for (size_t i = 0; i < 4; ++i) {
+        raw_data.push_back(static_cast<uint8_t>(table.size() >> (8 * i)));
+    }
+    raw_data.insert(raw_data.end(), table.begin(), table.end());
+
+    SMBios smbios = SMBios::from_raw_smbios_data(raw_data.data(), raw_data.size());
+    BOOST_CHECK_EQUAL(smbios.get_smbios_version().major_version, 3);
+    BOOST_CHECK_EQUAL(smbios.get_smbios_version().minor_version, 1);
+    BOOST_CHECK(smbios.get_table_base() == raw_data.data() + raw_smbios_data_header_size);
+    BOOST_CHECK_EQUAL(smbios.get_table_size(), table.size());
+    BOOST_CHECK_EQUAL(smbios.get_structures_count(), 5u);
+
+    // the same blob saved to file is recognized, raw table is not
+    std::string dump_path = write_temp_file("smbios_func_test_rsmb.bin", raw_data);
+    SMBios dump_smbios(dump_path);
+    BOOST_CHECK_EQUAL(dump_smbios.get_smbios_version().major_version, 3);
+    BOOST_CHECK_EQUAL(dump_smbios.get_table_size(), table.size());
+    boost::filesystem::remove(dump_path);
+
+    RawSMBiosDataInfo info;
+    BOOST_CHECK(!parse_raw_smbios_data(table.data(), table.size(), info));
+    BOOST_CHECK(!parse_raw_smbios_data(raw_data.data(), raw_data.size() - 1, info));
+    BOOST_CHECK_THROW(SMBios::from_raw_smbios_data(table.data(), table.size()), std::runtime_error);
+}
+
+/// Every scanner implementation finds the same entry point, SMBIOS3 is preferred, legacy is the last resort
+BOOST_AUTO_TEST_CASE(SMBiosAnchorScannerTestCase)
+{
+    std::vector<uint8_t> area(0x10000, 0xA5);
+    std::vector<uint8_t> entry_point32 = make_entry_point32(0xE0000, 0x400, 12);
+    std::vector<uint8_t> entry_point64 = make_entry_point64(0x7F000000, 0x1234);
+    std::vector<uint8_t> entry_point_legacy = make_entry_point_legacy(0xF1000, 0x200, 7);
+
+    // broken candidate first, then legacy, 32-bit, then 64-bit in the tail shorter than a block
+    std::copy(entry_point64.begin(), entry_point64.begin() + 5, area.begin() + 0x100);
+    std::copy(entry_point_legacy.begin(), entry_point_legacy.end(), area.begin() + 0x1000);
+    std::copy(entry_point32.begin(), entry_point32.end(), area.begin() + 0x2350);
+    std::copy(entry_point64.begin(), entry_point64.end(), area.begin() + 0xFFE0);
+
+    for (AnchorScanMethod method : {AnchorScanMethod::Scalar, AnchorScanMethod::SSE2,
+                                    AnchorScanMethod::AVX2, AnchorScanMethod::Auto}) {
+        SMBiosScanResult result = scan_smbios_entry_point(area.data(), area.size(), method);
+        BOOST_CHECK(result.entry_point == area.data() + 0xFFE0);
+        BOOST_CHECK_EQUAL(result.info.anchor_type, SMBiosAnchorType::SMBios64);
+
+        // 32-bit entry point only
+        result = scan_smbios_entry_point(area.data(), 0xF000, method);
+        BOOST_CHECK(result.entry_point == area.data() + 0x2350);
+        BOOST_CHECK_EQUAL(result.info.anchor_type, SMBiosAnchorType::SMBios32);
+
+        // legacy entry point only
+        result = scan_smbios_entry_point(area.data(), 0x2000, method);
+        BOOST_CHECK(result.entry_point == area.data() + 0x1000);
+        BOOST_CHECK_EQUAL(result.info.anchor_type, SMBiosAnchorType::SMBiosLegacy);
+        BOOST_CHECK_EQUAL(result.info.table_address, 0xF1000u);
+
+        // 32-bit entry point is preferred over its own intermediate legacy anchor
+        result = scan_smbios_entry_point(area.data() + 0x2000, 0x1000, method);
+        BOOST_CHECK(result.entry_point == area.data() + 0x2350);
+        BOOST_CHECK_EQUAL(result.info.anchor_type, SMBiosAnchorType::SMBios32);
+
+        result = scan_smbios_entry_point(area.data(), 0x1000, method);
+        BOOST_CHECK(result.entry_point == nullptr);
+    }
+}
+
+/// Streaming walk visits the same structures as the indexed table for any window size
+BOOST_AUTO_TEST_CASE(SMBiosTableStreamTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table(64);
+    SMBios smbios(table.data(), table.size());
+
+    for (size_t window_size : {8, 32, 100, 4096}) {
+        BufferTableStream stream(table, window_size);
+        auto indexed = smbios.begin();
+        size_t visited = stream.for_each_structure([&](const DMIHeader& header, size_t structure_size) {
+            BOOST_CHECK(indexed != smbios.end());
+            BOOST_CHECK_EQUAL(header.get_type(), (*indexed).get_type());
+            BOOST_CHECK_EQUAL(header.handle, (*indexed).handle);
+            BOOST_CHECK(std::equal(header.data, header.data + structure_size, (*indexed).data));
+            ++indexed;
+            return true;
+        });
+        BOOST_CHECK_EQUAL(visited, 66u);
+        BOOST_CHECK(indexed == smbios.end());
+
+        // window grows only for structures larger than the window
+        BOOST_CHECK(stream.get_max_window_size() <= std::max<size_t>(window_size, 64));
+    }
+
+    BufferTableStream stream(table, 32);
+    BOOST_CHECK_EQUAL(stream.for_each_structure([](const DMIHeader&, size_t) { return false; }), 1u);
+}
+
+/// Sources are tried in order, failed and budgeted sources are reported
+BOOST_AUTO_TEST_CASE(SMBiosAcquisitionPolicyTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    std::string dump_path = write_temp_file("smbios_func_test_policy.bin", table);
+
+    AcquisitionPolicy policy;
+    policy.steps = {{SMBiosSource::Memory}, {SMBiosSource::DumpFile, std::chrono::milliseconds(5000)}};
+    policy.deadline = std::chrono::milliseconds(10000);
+    policy.dump_file_path = dump_path;
+    policy.dump_major_version = 3;
+
+    SMBios smbios(policy);
+    const AcquisitionReport& report = smbios.get_acquisition_report();
+    BOOST_CHECK(report.source == SMBiosSource::DumpFile);
+    BOOST_REQUIRE_EQUAL(report.attempts.size(), 2u);
+    BOOST_CHECK(report.attempts[0].result == AcquisitionResult::Failed);
+    BOOST_CHECK(report.attempts[1].result == AcquisitionResult::Success);
+    BOOST_CHECK(report.total_latency >= report.attempts[1].latency);
+    BOOST_CHECK_EQUAL(smbios.get_smbios_version().major_version, 3);
+
+    // table stays in place when moved
+    const uint8_t* table_base = smbios.get_table_base();
+    SMBios moved(std::move(smbios));
+    BOOST_CHECK(moved.get_table_base() == table_base);
+    size_t headers = 0;
+    for (const DMIHeader& header : moved) {
+        BOOST_CHECK(header.data >= table_base);
+        ++headers;
+    }
+    BOOST_CHECK_EQUAL(headers, 4u);
+
+    policy.dump_file_path = "/nonexistent/smbios.bin";
+    BOOST_CHECK_THROW(SMBios{policy}, std::runtime_error);
+    boost::filesystem::remove(dump_path);
+}
+
+/// Lazy object is indexed once on the first query, concurrent queries see the same index
+BOOST_AUTO_TEST_CASE(SMBiosLazyIndexingTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table(16);
+    std::string dump_path = write_temp_file("smbios_func_test_lazy.bin", table);
+
+    AcquisitionPolicy policy;
+    policy.steps = {{SMBiosSource::DumpFile}};
+    policy.dump_file_path = dump_path;
+    policy.dump_major_version = 3;
+    policy.lazy_indexing = true;
+
+    SMBios smbios(policy);
+    BOOST_CHECK_EQUAL(smbios.get_smbios_version().major_version, 3);
+    BOOST_CHECK_EQUAL(smbios.get_table_size(), table.size());
+
+    std::vector<std::future<size_t>> counts;
+    for (size_t i = 0; i < 4; ++i) {
+        counts.push_back(std::async(std::launch::async, [&smbios]() {
+            size_t headers = 0;
+            for (auto it = smbios.begin(); it != smbios.end(); ++it) {
+                ++headers;
+            }
+            return headers;
+        }));
+    }
+    for (std::future<size_t>& count : counts) {
+        BOOST_CHECK_EQUAL(count.get(), 18u);
+    }
+    BOOST_CHECK_EQUAL(smbios.get_structures_count(), 19u);
+
+    // moved lazy object keeps its index
+    SMBios moved(std::move(smbios));
+    BOOST_CHECK_EQUAL(moved.get_structures_count(), 19u);
+    boost::filesystem::remove(dump_path);
+}
+
+/// Targeted walk stops as soon as enough structures are found
+BOOST_AUTO_TEST_CASE(SMBiosFindStructuresTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table(16);
+    SMBios smbios(table.data(), table.size());
+
+    std::vector<DMIHeader> found = smbios.find_structures(std::set<uint8_t>{SMBios::SystemInformation}, 1);
+    BOOST_REQUIRE_EQUAL(found.size(), 1u);
+    BOOST_CHECK_EQUAL(found.front().handle, 1);
+    BOOST_CHECK(found.front().data > table.data() && found.front().data < table.data() + table.size());
+
+    size_t visited = 0;
+    found = smbios.find_structures([&visited](const DMIHeader& header) {
+        ++visited;
+        return SMBios::MemoryDevice == header.type;
+    }, 2);
+    BOOST_CHECK_EQUAL(found.size(), 2u);
+    BOOST_CHECK_EQUAL(visited, 4u);
+
+    BOOST_CHECK_EQUAL(smbios.find_structures(std::set<uint8_t>{SMBios::MemoryDevice}).size(), 16u);
+    BOOST_CHECK(smbios.find_structures(std::set<uint8_t>{SMBios::EndOfTable}).empty());
+    BOOST_CHECK(smbios.find_structures(std::set<uint8_t>{SMBios::BIOSInformation}, 0).empty());
+}
+
+/// Table is acquired on the background thread, acquisition could be cancelled
+BOOST_AUTO_TEST_CASE(SMBiosAsyncCreationTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    std::string dump_path = write_temp_file("smbios_func_test_async.bin", table);
+
+    AcquisitionPolicy policy;
+    policy.steps = {{SMBiosSource::DumpFile}};
+    policy.dump_file_path = dump_path;
+    policy.dump_major_version = 3;
+    policy.cancel_flag = std::make_shared<std::atomic<bool>>(false);
+
+    std::future<SMBios> pending = SMBios::create_async(policy);
+    SMBios smbios = pending.get();
+    BOOST_CHECK(smbios.get_acquisition_report().source == SMBiosSource::DumpFile);
+    BOOST_CHECK_EQUAL(smbios.get_structures_count(), 5u);
+
+    std::promise<size_t> callback_result;
+    SMBios::create_async(policy, [&callback_result](std::unique_ptr<SMBios> created, std::exception_ptr error) {
+        callback_result.set_value(created && !error ? created->get_structures_count() : 0);
+    });
+    BOOST_CHECK_EQUAL(callback_result.get_future().get(), 5u);
+
+    // cancelled acquisition does not try sources
+    policy.cancel_flag->store(true);
+    BOOST_CHECK_THROW(SMBios::create_async(policy).get(), std::runtime_error);
+
+    std::promise<bool> callback_error;
+    SMBios::create_async(policy, [&callback_error](std::unique_ptr<SMBios> created, std::exception_ptr error) {
+        callback_error.set_value(!created && error);
+    });
+    BOOST_CHECK(callback_error.get_future().get());
+    boost::filesystem::remove(dump_path);
+}
+
+/// Process-wide table is shared until it is refreshed explicitly
+BOOST_AUTO_TEST_CASE(SMBiosInstanceTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    std::string dump_path = write_temp_file("smbios_func_test_instance.bin", table);
+
+    AcquisitionPolicy policy;
+    policy.steps = {{SMBiosSource::DumpFile}};
+    policy.dump_file_path = dump_path;
+    policy.dump_major_version = 3;
+
+    std::shared_ptr<const SMBios> refreshed = SMBios::refresh_instance(policy);
+    BOOST_CHECK(refreshed->get_acquisition_report().source == SMBiosSource::DumpFile);
+
+    std::vector<std::future<std::shared_ptr<const SMBios>>> consumers;
+    for (size_t i = 0; i < 4; ++i) {
+        consumers.push_back(std::async(std::launch::async, [] { return SMBios::instance(); }));
+    }
+    for (auto& consumer : consumers) {
+        BOOST_CHECK(consumer.get() == refreshed);
+    }
+
+    // immutable table is iterated through the const object
+    size_t headers_count = 0;
+    for (const DMIHeader& header : *SMBios::instance()) {
+        (void)header;
+        ++headers_count;
+    }
+    BOOST_CHECK_EQUAL(headers_count, 4u);
+
+    // previous table is kept by its holders
+    std::shared_ptr<const SMBios> replaced = SMBios::refresh_instance(policy);
+    BOOST_CHECK(replaced != refreshed);
+    BOOST_CHECK(SMBios::instance() == replaced);
+    BOOST_CHECK_EQUAL(refreshed->get_structures_count(), 5u);
+    boost::filesystem::remove(dump_path);
+}
+
+/// System Information is decoded in the same form as kernel exports it
+BOOST_AUTO_TEST_CASE(SystemInformationEntryTestCase)
+{
+    std::vector<uint8_t> table;
+    append_structure(table, SMBios::SystemInformation, 0x1B, 1, {"Maker", "Product", "1", "Serial", "SKU", "Family"});
+    const uint8_t uuid[16] = {0x33, 0x22, 0x11, 0x00, 0x55, 0x44, 0x77, 0x66,
+                              0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+    std::copy(std::begin(uuid), std::end(uuid), table.begin() + 8);
+    append_structure(table, SMBios::EndOfTable, 4, 0xFFFF, {});
+
+    SMBios smbios(table.data(), table.size());
+    SMBiosEntryFactory smbios_factory;
+    std::unique_ptr<AbstractSMBiosEntry> entry = smbios_factory.create(*smbios.begin(), SMBiosVersion{3, 2});
+    BOOST_REQUIRE(entry);
+
+    const SystemInformationEntry* system_information = dynamic_cast<const SystemInformationEntry*>(entry.get());
+    BOOST_REQUIRE(system_information);
+    BOOST_CHECK_EQUAL(system_information->get_manufacturer_string(), "Maker");
+    BOOST_CHECK_EQUAL(system_information->get_version_string(), "1");
+    BOOST_CHECK_EQUAL(system_information->get_serial_number_string(), "Serial");
+    BOOST_CHECK_EQUAL(system_information->get_uuid_string(), "00112233-4455-6677-8899-aabbccddeeff");
+
+    SystemInformationEntry legacy_order(*smbios.begin(), SMBiosVersion{2, 5});
+    BOOST_CHECK_EQUAL(legacy_order.get_uuid_string(), "33221100-5544-7766-8899-aabbccddeeff");
+}
+
+/// Identity is read once per process, once some field is readable
+BOOST_AUTO_TEST_CASE(SystemIdentityTestCase)
+{
+    const SystemIdentity& identity = get_system_identity();
+    BOOST_TEST_MESSAGE("Product UUID: " << identity.product_uuid << ", serial: " << identity.product_serial
+                       << ", BIOS: " << identity.bios_vendor << ' ' << identity.bios_version);
+    if (!identity.system_vendor.empty() || !identity.bios_vendor.empty()) {
+        BOOST_CHECK(&identity == &get_system_identity());
+    }
+    BOOST_CHECK_EQUAL(get_system_identity().product_name, identity.product_name);
+}
+
+/// Every Linux source reads the fixture tree instead of the system one
+BOOST_AUTO_TEST_CASE(SMBiosFilesystemRootTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    boost::filesystem::path root = make_fixture_root(table);
+
+    AcquisitionPolicy policy;
+    policy.root_path = root.string();
+    for (SMBiosSource source : {SMBiosSource::SysFS, SMBiosSource::EFI, SMBiosSource::PhysicalMemoryScan}) {
+        policy.steps = {{source}};
+        SMBios smbios(policy);
+        BOOST_CHECK(smbios.get_acquisition_report().source == source);
+        BOOST_CHECK_EQUAL(smbios.get_table_size(), table.size());
+        BOOST_CHECK(std::equal(table.begin(), table.end(), smbios.get_table_base()));
+        BOOST_CHECK_EQUAL(smbios.get_smbios_version().major_version, SMBiosSource::SysFS == source ? 3 : 2);
+
+        // entry point validated by the source is kept together with the table
+        std::vector<uint8_t> snapshot = smbios.make_snapshot();
+        SMBiosSnapshotInfo snapshot_info;
+        BOOST_REQUIRE(parse_smbios_snapshot(snapshot.data(), snapshot.size(), snapshot_info));
+        BOOST_CHECK_NE(snapshot_info.entry_point_length, 0u);
+        BOOST_CHECK(!smbios.render_to_description().empty());
+    }
+
+    SMBios memory_devices(std::set<uint8_t>{SMBios::MemoryDevice}, root.string());
+    BOOST_CHECK(memory_devices.get_acquisition_report().source == SMBiosSource::SysFSEntries);
+    BOOST_CHECK_EQUAL(memory_devices.get_structures_count(), 2u);
+    BOOST_CHECK_EQUAL(memory_devices.get_smbios_version().major_version, 3);
+    BOOST_CHECK(!memory_devices.render_to_description().empty());
+
+    SystemIdentity identity = read_system_identity(root.string());
+    BOOST_CHECK_EQUAL(identity.system_vendor, "Maker");
+    BOOST_CHECK_EQUAL(identity.product_serial, "Serial");
+    BOOST_CHECK_EQUAL(identity.bios_version, "1.0");
+    BOOST_CHECK(identity.decoded_from_table);
+
+    SMBiosTableStream stream(fixture_table_address, table.size(), 32, root.string());
+    BOOST_CHECK_EQUAL(stream.for_each_structure([](const DMIHeader&, size_t) { return true; }), 4u);
+
+    PhysicalMemory::release_cached_mappings();
+    boost::filesystem::remove_all(root);
+}
+
+/// Probe reads only the entry point of the first available source
+BOOST_AUTO_TEST_CASE(SMBiosProbeTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    boost::filesystem::path root = make_fixture_root(table);
+
+    AcquisitionPolicy policy;
+    policy.root_path = root.string();
+    for (SMBiosSource source : {SMBiosSource::SysFS, SMBiosSource::EFI, SMBiosSource::PhysicalMemoryScan}) {
+        policy.steps = {{SMBiosSource::Memory}, {source}};
+        SMBiosProbe probe = SMBios::probe(policy);
+        BOOST_CHECK(probe.source == source);
+        BOOST_CHECK_EQUAL(probe.entry_point.major_version, SMBiosSource::SysFS == source ? 3u : 2u);
+        BOOST_CHECK_EQUAL(probe.entry_point.table_length, table.size());
+        if (SMBiosSource::SysFS != source) {
+            BOOST_CHECK_EQUAL(probe.entry_point.table_address, fixture_table_address);
+            BOOST_CHECK_EQUAL(probe.entry_point.structures_number, 5u);
+        }
+    }
+
+    // raw dump takes the version from policy
+    policy.steps = {{SMBiosSource::DumpFile}};
+    policy.dump_file_path = write_temp_file("smbios_func_test_probe.bin", table);
+    policy.dump_major_version = 2;
+    policy.dump_minor_version = 7;
+    SMBiosProbe probe = SMBios::probe(policy);
+    BOOST_CHECK(probe.source == SMBiosSource::DumpFile);
+    BOOST_CHECK_EQUAL(probe.entry_point.minor_version, 7u);
+    BOOST_CHECK_EQUAL(probe.entry_point.table_length, table.size());
+    boost::filesystem::remove(policy.dump_file_path);
+
+    policy.steps = {{SMBiosSource::EFI}};
+    policy.root_path = (root / "nonexistent").string();
+    BOOST_CHECK_THROW(SMBios::probe(policy), std::runtime_error);
+
+    PhysicalMemory::release_cached_mappings();
+    boost::filesystem::remove_all(root);
+}
+
+/// Table is taken from the boot cache while boot id and entry point are the same
+BOOST_AUTO_TEST_CASE(SMBiosBootCacheTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table();
+    boost::filesystem::path root = make_fixture_root(table);
+    boost::filesystem::path cache_directory = root / "cache";
+    boost::filesystem::create_directories(cache_directory);
+    write_file(root / "proc/sys/kernel/random/boot_id", {'1', '2', '-', 'a', 'b', '\n'});
+
+    AcquisitionPolicy policy;
+    policy.root_path = root.string();
+    policy.steps = {{SMBiosSource::SysFS}};
+    policy.cache_directory = cache_directory.string();
+
+    SMBios acquired(policy);
+    BOOST_CHECK(acquired.get_acquisition_report().source == SMBiosSource::SysFS);
+    const std::string cache_path = get_boot_cache_path(policy);
+    // smbios-<root hash>-<boot id>-<entry point checksum>.cache
+    const std::string cache_name = boost::filesystem::path(cache_path).filename().string();
+    BOOST_CHECK_EQUAL(cache_name.substr(0, 7), "smbios-");
+    BOOST_CHECK_EQUAL(cache_name.substr(15, 7), "-12-ab-");
+    BOOST_CHECK_EQUAL(boost::filesystem::path(cache_path).extension().string(), ".cache");
+    BOOST_CHECK(boost::filesystem::exists(cache_path));
+
+    SMBios cached(policy);
+    BOOST_CHECK(cached.get_acquisition_report().source == SMBiosSource::Cache);
+    BOOST_CHECK(cached.get_acquisition_report().snapshot_source == SMBiosSource::SysFS);
+    BOOST_CHECK_EQUAL(cached.get_structures_count(), acquired.get_structures_count());
+    BOOST_CHECK_EQUAL(cached.get_smbios_version().major_version, 3);
+    BOOST_CHECK(std::equal(table.begin(), table.end(), cached.get_table_base()));
+
+    // cached object is the same as acquired one, including the entry point
+    BOOST_CHECK(!acquired.render_to_description().empty());
+    BOOST_CHECK_EQUAL(cached.render_to_description(), acquired.render_to_description());
+    BOOST_CHECK(cached.make_dump_bin() == acquired.make_dump_bin());
+
+    // cache writable by others could have been planted, it is acquired again and rewritten
+    namespace fs = boost::filesystem;
+    fs::permissions(cache_path, fs::owner_read | fs::owner_write | fs::others_write);
+    BOOST_CHECK(SMBios(policy).get_acquisition_report().source == SMBiosSource::SysFS);
+    BOOST_CHECK(SMBios(policy).get_acquisition_report().source == SMBiosSource::Cache);
+
+    // entry point of other firmware with the same checksum byte
+    std::vector<uint8_t> entry_point = make_entry_point64(0, static_cast<uint32_t>(table.size()));
+    SMBIOSEntryPoint64* other_entry_point = reinterpret_cast<SMBIOSEntryPoint64*>(entry_point.data());
+    other_entry_point->structure_table_address += 1;
+    other_entry_point->reserved -= 1;
+    write_file(cache_path, SMBios(table.data(), table.size(), entry_point.data(), entry_point.size()).make_snapshot());
+    fs::permissions(cache_path, fs::owner_read | fs::owner_write);
+    BOOST_CHECK(SMBios(policy).get_acquisition_report().source == SMBiosSource::SysFS);
+
+    // memory scan is never run out of the acquisition budget just to make the key
+    AcquisitionPolicy scan_policy = policy;
+    scan_policy.steps = {{SMBiosSource::PhysicalMemoryScan}};
+    BOOST_CHECK(get_boot_cache_path(scan_policy).empty());
+
+    // next boot: table is acquired again, cache of the previous boot is removed,
+    // cache of the other root sharing the directory is kept
+    const boost::filesystem::path other_root_cache = cache_directory / "smbios-00000000-12-ab-00.cache";
+    write_file(other_root_cache, table);
+    write_file(root / "proc/sys/kernel/random/boot_id", {'c', 'd', '\n'});
+    SMBios next_boot(policy);
+    BOOST_CHECK(next_boot.get_acquisition_report().source == SMBiosSource::SysFS);
+    BOOST_CHECK(!boost::filesystem::exists(cache_path));
+    BOOST_CHECK(boost::filesystem::exists(get_boot_cache_path(policy)));
+    BOOST_CHECK(boost::filesystem::exists(other_root_cache));
+
+    PhysicalMemory::release_cached_mappings();
+    boost::filesystem::remove_all(root);
+}
+
+/// Published snapshot is attached in place by any process
+BOOST_AUTO_TEST_CASE(SMBiosSharedMemoryTestCase)
+{
+    std::vector<uint8_t> table = make_smbios_table(4);
+    std::vector<uint8_t> entry_point = make_entry_point64(0, static_cast<uint32_t>(table.size()));
+    SMBios publisher(table.data(), table.size(), entry_point.data(), entry_point.size());
+
+    AcquisitionPolicy policy;
+    policy.steps = {{SMBiosSource::SharedMemory}};
+    policy.shared_memory_name = boost::filesystem::unique_path("/smbios_func_test_%%%%%%%%").string();
+    BOOST_CHECK_THROW(SMBios{policy}, std::runtime_error);
+
+    publisher.publish_shared_memory(policy.shared_memory_name);
+    SMBios attached(policy);
+    BOOST_CHECK(attached.get_acquisition_report().source == SMBiosSource::SharedMemory);
+    BOOST_CHECK(attached.get_acquisition_report().snapshot_source == SMBiosSource::Memory);
+    BOOST_CHECK_EQUAL(attached.get_smbios_version().major_version, 3);
+    BOOST_CHECK_EQUAL(attached.get_structures_count(), publisher.get_structures_count());
+    BOOST_CHECK(std::equal(table.begin(), table.end(), attached.get_table_base()));
+    BOOST_CHECK_EQUAL(SMBios::probe(policy).entry_point.table_length, table.size());
+
+    // attached object keeps its segment after the name is removed
+    BOOST_CHECK(SharedMemorySegment::remove(policy.shared_memory_name));
+    size_t headers = 0;
+    for (const DMIHeader& header : attached) {
+        BOOST_CHECK(header.data >= attached.get_table_base());
+        ++headers;
+    }
+    BOOST_CHECK_EQUAL(headers, 6u);
+    BOOST_CHECK(!SharedMemorySegment::remove(policy.shared_memory_name));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
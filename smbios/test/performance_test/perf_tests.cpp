@@ -2,8 +2,14 @@
 #include <string>
 #include <iostream>
 #include <chrono>
+#include <algorithm>
+#include <set>
+#include <fstream>
+#include <boost/filesystem.hpp>
 #include <smbios/smbios.h>
 #include <smbios/smbios_entry_factory.h>
+#include <smbios/smbios_anchor_scanner.h>
+#include <smbios/physical_memory.h>
 
 #define BOOST_AUTO_TEST_MAIN
 
@@ -26,6 +32,42 @@ struct TimedObject
     mcs delay() { return std::chrono::duration_cast<mcs>(clock::now() - _timestamp); }
 };
 
+namespace {
+
+/// Append structures of the type, formatted area is filled with ones, every structure has the same strings
+void append_structures(std::vector<uint8_t>& table, uint8_t type, uint8_t length, size_t count,
+                       const std::vector<std::string>& strings)
+{
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t structure[] = {type, length, static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8)};
+        table.insert(table.end(), std::begin(structure), std::end(structure));
+        table.resize(table.size() + length - sizeof(structure), 1);
+        for (const std::string& dmi_string : strings) {
+            table.insert(table.end(), dmi_string.begin(), dmi_string.end());
+            table.push_back(0);
+        }
+        table.push_back(0);
+    }
+}
+
+/// Append end of table marker
+void append_end_of_table(std::vector<uint8_t>& table)
+{
+    const uint8_t end_of_table[] = {127, 4, 0xFF, 0xFF, 0, 0};
+    table.insert(table.end(), std::begin(end_of_table), std::end(end_of_table));
+}
+
+/// Table of memory devices with a few strings each
+std::vector<uint8_t> make_memory_device_table(size_t count)
+{
+    std::vector<uint8_t> table;
+    append_structures(table, 17, 0x28, count, {"DIMM_A1", "Manufacturer", "SerialNumber"});
+    append_end_of_table(table);
+    return table;
+}
+
+} // namespace
+
 BOOST_AUTO_TEST_SUITE(SmbiosPerformanceTests);
 
 // Just measure time of SMBios enumeration
@@ -52,4 +94,179 @@ BOOST_AUTO_TEST_CASE(PerformanceTestsCase)
     BOOST_TEST_MESSAGE("Total enumeration time: " << counter.delay().count() << " mcs");
 }
 
+// Entry point scan throughput over the multi-megabyte capture, entry point is at the very end
+BOOST_AUTO_TEST_CASE(AnchorScannerPerformanceTestCase)
+{
+    const size_t capture_size = 16 * 1024 * 1024;
+    const size_t iterations = 20;
+
+    // pseudo-random capture with a lot of '_' bytes, without valid anchors
+    std::vector<uint8_t> capture(capture_size);
+    uint32_t seed = 0x12345678;
+    for (uint8_t& byte : capture) {
+        seed = seed * 1103515245 + 12345;
+        byte = (seed >> 24) & 1 ? '_' : static_cast<uint8_t>(seed >> 16);
+    }
+
+    // valid SMBIOS3 entry point at the last paragraph boundary it fits
+    const uint8_t entry_point[] = {'_', 'S', 'M', '3', '_', 0, 0x18, 3, 0, 0, 1, 0,
+                                   0, 0x10, 0, 0, 0, 0, 0, 0x7F, 0, 0, 0, 0};
+    const size_t entry_point_offset = capture_size - 32;
+    std::copy(std::begin(entry_point), std::end(entry_point), capture.begin() + entry_point_offset);
+    uint8_t sum{};
+    for (size_t i = 0; i < sizeof(entry_point); ++i) {
+        sum += capture[entry_point_offset + i];
+    }
+    capture[entry_point_offset + 5] = static_cast<uint8_t>(0x100 - sum);
+
+    for (AnchorScanMethod method : {AnchorScanMethod::Scalar, AnchorScanMethod::SSE2, AnchorScanMethod::AVX2}) {
+
+        if (resolve_anchor_scan_method(method) != method) {
+            BOOST_TEST_MESSAGE("Scan method " << static_cast<int>(method) << " is not supported, skipped");
+            continue;
+        }
+
+        TimedObject counter;
+        const uint8_t* found = nullptr;
+        for (size_t i = 0; i < iterations; ++i) {
+            found = scan_smbios_entry_point(capture.data(), capture.size(), method).entry_point;
+        }
+        BOOST_CHECK(found == capture.data() + entry_point_offset);
+
+        double seconds = std::max<double>(counter.delay().count(), 1) / 1e6;
+        double megabytes = static_cast<double>(capture_size) * iterations / (1024 * 1024);
+        BOOST_TEST_MESSAGE("Scan method " << static_cast<int>(method) << ": "
+                           << megabytes / seconds << " MB/s");
+    }
+}
+
+// Compare read and map access to the legacy BIOS area of growing size on the running kernel
+BOOST_AUTO_TEST_CASE(PhysicalMemoryAccessPerformanceTestCase)
+{
+    const size_t area_base = 0xF0000;
+    const size_t iterations = 100;
+
+    try {
+        for (size_t length = 64; length <= 0x10000; length *= 4) {
+            for (PhysicalMemoryAccess access : {PhysicalMemoryAccess::Read, PhysicalMemoryAccess::Map}) {
+
+                TimedObject counter;
+                for (size_t i = 0; i < iterations; ++i) {
+                    // measure the first access, not the cached mapping
+                    PhysicalMemory::release_cached_mappings();
+                    PhysicalMemory memory(area_base, length, access);
+                    BOOST_CHECK(!memory.get_memory_view(0, length).empty());
+                }
+                BOOST_TEST_MESSAGE((access == PhysicalMemoryAccess::Read ? "Read " : "Map ")
+                                   << length << " bytes: " << counter.delay().count() / double(iterations) << " mcs");
+            }
+        }
+
+        size_t threshold = PhysicalMemory::calibrate_read_threshold(area_base, 0x10000);
+        BOOST_TEST_MESSAGE("Calibrated read threshold: " << threshold << " bytes");
+    }
+    catch (const std::exception& e) {
+        BOOST_TEST_MESSAGE("Physical memory is not accessible: " << e.what());
+    }
+}
+
+// Reload of the same table from raw dump (scan and count) and from snapshot (precomputed index)
+BOOST_AUTO_TEST_CASE(SnapshotReloadPerformanceTestCase)
+{
+    const size_t structures = 20000;
+    const size_t iterations = 50;
+
+    std::vector<uint8_t> table = make_memory_device_table(structures);
+
+    const boost::filesystem::path temp_path = boost::filesystem::temp_directory_path();
+    const std::string dump_path = (temp_path / "smbios_perf_test_dump.bin").string();
+    const std::string snapshot_path = (temp_path / "smbios_perf_test_snapshot.bin").string();
+    std::vector<uint8_t> snapshot = SMBios(table.data(), table.size()).make_snapshot();
+    std::ofstream(dump_path, std::ios::binary).write(reinterpret_cast<const char*>(table.data()), table.size());
+    std::ofstream(snapshot_path, std::ios::binary).write(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
+
+    for (const std::string& path : {dump_path, snapshot_path}) {
+        TimedObject counter;
+        size_t count = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            SMBios smbios(path, SMBiosVersion{3, 0});
+            count = smbios.get_structures_count();
+        }
+        BOOST_CHECK_EQUAL(count, structures + 1);
+        BOOST_TEST_MESSAGE((path == dump_path ? "Raw dump" : "Snapshot") << " reload: "
+                           << counter.delay().count() / double(iterations) << " mcs");
+    }
+
+    boost::filesystem::remove(dump_path);
+    boost::filesystem::remove(snapshot_path);
+}
+
+// Identity lookup on the table with many OEM structures: full index vs targeted walk
+BOOST_AUTO_TEST_CASE(FindStructuresPerformanceTestCase)
+{
+    const size_t oem_structures = 20000;
+    const size_t iterations = 50;
+
+    std::vector<uint8_t> table;
+    const uint8_t bios_information[] = {0, 4, 0, 0, 0, 0};
+    const uint8_t system_information[] = {1, 4, 1, 0, 0, 0};
+    table.insert(table.end(), std::begin(bios_information), std::end(bios_information));
+    table.insert(table.end(), std::begin(system_information), std::end(system_information));
+    append_structures(table, 0xC0, 0x10, oem_structures, {"OEM"});
+    append_end_of_table(table);
+
+    const std::string dump_path = (boost::filesystem::temp_directory_path() / "smbios_perf_test_find.bin").string();
+    std::ofstream(dump_path, std::ios::binary).write(reinterpret_cast<const char*>(table.data()), table.size());
+
+    AcquisitionPolicy policy;
+    policy.steps = {{SMBiosSource::DumpFile}};
+    policy.dump_file_path = dump_path;
+    policy.dump_major_version = 3;
+    policy.lazy_indexing = true;
+
+    const std::set<uint8_t> identity_types{SMBios::BIOSInformation, SMBios::SystemInformation};
+    for (bool targeted : {false, true}) {
+        TimedObject counter;
+        size_t found = 0;
+        for (size_t i = 0; i < iterations; ++i) {
+            SMBios smbios(policy);
+            if (targeted) {
+                found = smbios.find_structures(identity_types, 2).size();
+            }
+            else {
+                found = 0;
+                for (const DMIHeader& header : smbios) {
+                    found += identity_types.count(header.type);
+                }
+            }
+        }
+        BOOST_CHECK_EQUAL(found, 2u);
+        BOOST_TEST_MESSAGE((targeted ? "Targeted walk" : "Full index") << " identity lookup: "
+                           << counter.delay().count() / double(iterations) << " mcs");
+    }
+
+    boost::filesystem::remove(dump_path);
+}
+
+// Indexing throughput on the synthetic large table
+BOOST_AUTO_TEST_CASE(IndexingThroughputPerformanceTestCase)
+{
+    const size_t structures = 1000000;
+    const size_t iterations = 10;
+
+    // ~70 MB
+    std::vector<uint8_t> table = make_memory_device_table(structures);
+
+    TimedObject counter;
+    size_t count = 0;
+    for (size_t i = 0; i < iterations; ++i) {
+        SMBios smbios(table.data(), table.size());
+        count = smbios.get_structures_count(SMBios::MemoryDevice);
+    }
+    const double seconds = counter.delay().count() / 1e6;
+    BOOST_CHECK_EQUAL(count, structures);
+    BOOST_TEST_MESSAGE("Indexing throughput: " << table.size() * iterations / seconds / 1e9 << " GB/s ("
+                       << table.size() << " bytes table, " << seconds * 1e6 / iterations << " mcs)");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -38,6 +38,10 @@ public:
         return _memory_scan;
     }
 
+    bool is_probe() const {
+        return _probe;
+    }
+
     const std::string& read_from_file() const {
         return _from_file;
     }
@@ -46,6 +50,26 @@ public:
         return _to_file;
     }
 
+    const std::string& dump_bin_to_file() const {
+        return _to_dump_bin;
+    }
+
+    const std::string& snapshot_to_file() const {
+        return _to_snapshot;
+    }
+
+    const std::string& publish_name() const {
+        return _publish_name;
+    }
+
+    const std::string& attach_name() const {
+        return _attach_name;
+    }
+
+    const std::string& root_path() const {
+        return _root_path;
+    }
+
 
 private:
 
@@ -58,12 +82,30 @@ private:
     /// Fallback right to memory scan
     bool _memory_scan = false;
 
+    /// Entry point only
+    bool _probe = false;
+
     /// This file should contain SMBios dump
     std::string _from_file;
 
     /// Dump SMBios to that file
     std::string _to_file;
 
+    /// Dump entry point and SMBios to that file, dmidecode format
+    std::string _to_dump_bin;
+
+    /// Save SMBios snapshot to that file
+    std::string _to_snapshot;
+
+    /// Publish SMBios snapshot into that shared memory segment
+    std::string _publish_name;
+
+    /// Read SMBios snapshot from that shared memory segment
+    std::string _attach_name;
+
+    /// Filesystem root of sysfs, procfs and /dev/mem
+    std::string _root_path;
+
     /// Command-line params description
     boost::program_options::options_description cmd_options_description;
 };
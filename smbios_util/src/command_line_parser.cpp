@@ -18,9 +18,15 @@ void CommandLineParams::read_params(int argc, char* argv[])
     cmd_options_description.add_options()
         ("help,h", "Print usage")
         ("version,v", "Print version")
+        ("probe,p", "Print entry point information only, the table is not read")
         ("memory-scan,m", "Fallback to memory scan without trying EFI or SysFS (Linux only)")
         ("read-file,r", po::value<string>(&_from_file), "Read SMBIOS table dump from this file")
         ("dump-file,d", po::value<string>(&_to_file), "Dump existing SMBIOS table to this file")
+        ("dump-bin,b", po::value<string>(&_to_dump_bin), "Dump entry point and SMBIOS table to this file (dmidecode --dump-bin format)")
+        ("snapshot,s", po::value<string>(&_to_snapshot), "Save SMBIOS snapshot with precomputed index to this file")
+        ("publish", po::value<string>(&_publish_name), "Publish SMBIOS snapshot into this POSIX shared memory segment (\"/smbios\")")
+        ("attach", po::value<string>(&_attach_name), "Read SMBIOS snapshot published into this POSIX shared memory segment")
+        ("root", po::value<string>(&_root_path), "Read sysfs, procfs and /dev/mem inside this directory (Linux only)")
         ;
 
     // command line params processing
@@ -31,6 +37,7 @@ void CommandLineParams::read_params(int argc, char* argv[])
     set_flag(cmd_variables_map, _help, "help");
     set_flag(cmd_variables_map, _version, "version");
     set_flag(cmd_variables_map, _memory_scan, "memory-scan");
+    set_flag(cmd_variables_map, _probe, "probe");
 
     // do not check debug flags!
     std::list<bool> mutually_exclusives = { _help, _version, _memory_scan };
@@ -1,6 +1,8 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <memory>
+#include <vector>
 #include <smbios/smbios.h>
 #include <smbios/memory_device_entry.h>
 #include <smbios/smbios_entry_factory.h>
@@ -32,7 +34,12 @@ int main(int argc, char* argv[]){
 
     setlocale(0, "");
     std::string dump_to_file;
+    std::string dump_bin_to_file;
+    std::string snapshot_to_file;
+    std::string publish_name;
     std::string read_from_file;
+    AcquisitionPolicy policy;
+    bool probe = false;
 
     try {
         get_params().read_params(argc, argv);
@@ -47,7 +54,23 @@ int main(int argc, char* argv[]){
         }
 
         dump_to_file = cmd_line_params.dump_to_file();
+        dump_bin_to_file = cmd_line_params.dump_bin_to_file();
+        snapshot_to_file = cmd_line_params.snapshot_to_file();
+        publish_name = cmd_line_params.publish_name();
         read_from_file = cmd_line_params.read_from_file();
+        policy.root_path = cmd_line_params.root_path();
+        if (cmd_line_params.is_memory_scan()) {
+            policy.steps = {{SMBiosSource::PhysicalMemoryScan}};
+        }
+        probe = cmd_line_params.is_probe();
+        if (!cmd_line_params.attach_name().empty()) {
+            policy.steps = {{SMBiosSource::SharedMemory}};
+            policy.shared_memory_name = cmd_line_params.attach_name();
+        }
+        if (!read_from_file.empty()) {
+            policy.steps = {{SMBiosSource::DumpFile}};
+            policy.dump_file_path = read_from_file;
+        }
     }
     // boost::program_options exception reports
     // about wrong command line parameters usage
@@ -59,28 +82,64 @@ int main(int argc, char* argv[]){
 
 
     try{
-        SMBios bios;
-
-        if (!read_from_file.empty()) {
-            // TODO: read dump from file
-            // create SMBios in empty state
-            // use read_physical_memory without scanning sources
+        if (probe) {
+            SMBiosProbe probe_result = SMBios::probe(policy);
+            std::cout << "DMI version: " << probe_result.entry_point.major_version << '.' << probe_result.entry_point.minor_version << '\n';
+            std::cout << "Table address: " << std::hex << probe_result.entry_point.table_address << std::dec << '\n';
+            std::cout << "Table length: " << probe_result.entry_point.table_length << '\n';
+            std::cout << "SMBIOS structures count: " << probe_result.entry_point.structures_number << '\n';
+            std::cout << "Table source: " << get_source_name(probe_result.source) << '\n';
+            return EXIT_SUCCESS;
         }
 
+        // dump file (raw table, raw SMBIOS data, dmidecode --dump-bin or snapshot) is indexed in place
+        // without scanning system sources
+        std::unique_ptr<SMBios> bios_source = read_from_file.empty()
+                ? std::make_unique<SMBios>(policy)
+                : std::make_unique<SMBios>(read_from_file);
+        SMBios& bios = *bios_source;
+
         SMBiosVersion ver = bios.get_smbios_version();
         std::cout << "DMI version: " << ver.major_version << '.' << ver.minor_version << '\n';
         std::cout << "Table size: " << bios.get_table_size() << '\n';
+        std::cout << "Table source: " << get_source_name(bios.get_acquisition_report().source) << '\n';
+        if (SMBiosSource::None != bios.get_acquisition_report().snapshot_source) {
+            std::cout << "Snapshot source: " << get_source_name(bios.get_acquisition_report().snapshot_source) << '\n';
+        }
         std::cout << bios.render_to_description();
 
         if (!dump_to_file.empty()) {
-            std::basic_ofstream<uint8_t, std::char_traits<uint8_t>> is(dump_to_file, std::ios::binary);
+            // char stream: uint8_t stream has no codecvt facet and writes nothing
+            std::ofstream is(dump_to_file, std::ios::binary);
             const uint8_t* table_begin = bios.get_table_base();
             size_t table_size = bios.get_table_size();
-            is.write(table_begin, table_size);
+            is.write(reinterpret_cast<const char*>(table_begin), table_size);
             cout << "Dump SMBIOS table to file " << dump_to_file << ", size = " << table_size << '\n';
             return EXIT_SUCCESS;
         }
 
+        if (!dump_bin_to_file.empty()) {
+            std::ofstream is(dump_bin_to_file, std::ios::binary);
+            std::vector<uint8_t> dump = bios.make_dump_bin();
+            is.write(reinterpret_cast<const char*>(dump.data()), dump.size());
+            cout << "Dump SMBIOS entry point and table to file " << dump_bin_to_file << ", size = " << dump.size() << '\n';
+            return EXIT_SUCCESS;
+        }
+
+        if (!snapshot_to_file.empty()) {
+            std::ofstream is(snapshot_to_file, std::ios::binary);
+            std::vector<uint8_t> snapshot = bios.make_snapshot();
+            is.write(reinterpret_cast<const char*>(snapshot.data()), snapshot.size());
+            cout << "Save SMBIOS snapshot to file " << snapshot_to_file << ", size = " << snapshot.size() << '\n';
+            return EXIT_SUCCESS;
+        }
+
+        if (!publish_name.empty()) {
+            bios.publish_shared_memory(publish_name);
+            cout << "Publish SMBIOS snapshot to shared memory " << publish_name << '\n';
+            return EXIT_SUCCESS;
+        }
+
         SMBiosEntryFactory smbios_factory;
         for (const DMIHeader& header : bios) {
 